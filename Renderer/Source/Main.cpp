@@ -0,0 +1,456 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 18 Oct 2026 7:13:13am
+    Author:  Adison
+
+    Headless renderer: converts an image, or every image in a folder, with the
+    same native pipeline as the plugin and reports per-image timings as JSON
+    lines. No GUI modules and no Python. With --daemon it runs the shared
+    GenerationDaemon instead.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../Source/AutoResolution.h"
+#include "../../Source/BatchConverter.h"
+#include "../../Source/ExtendedFeatures.h"
+#include "../../Source/GenerationDaemon.h"
+#include "../../Source/ImageLoader.h"
+#include "../../Source/ParameterSweep.h"
+#include "../../Source/SequenceRenderer.h"
+#include <algorithm>
+#include <functional>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <memory>
+
+namespace
+{
+    const char* const usage =
+        "Usage: ImagineRenderer <image or folder> [options]\n"
+        "       ImagineRenderer --daemon [--workers <n>]\n"
+        "\n"
+        "  --output <folder>                     where WAVs go (default ./output)\n"
+        "  --report <file>                       write the timing report there instead of stdout\n"
+        "  --sample-rate <hz>                    default 44100\n"
+        "  --sweep <name=v1,v2;name=...>         render every combination into {image}_sweep/\n"
+        "  --auto-resolution [max windows]       choose kernel and step per image (default 20000 windows)\n"
+        "  --sequence                            render a folder's frames into one continuous {folder}_sequence.wav\n"
+        "  --fps <n>                             sequence frames per second (default 24)\n"
+        "  --no-incremental                      extract every sequence frame in full\n"
+        "\n"
+        "Generation parameters, defaults as in the plugin:\n"
+        "  --kernel-size <n>                     25\n"
+        "  --step-size <n>                       10\n"
+        "  --sound-level <x>                     1.0\n"
+        "  --duration <seconds>                  10.0\n"
+        "  --modulation-intensity <x>            0.8\n"
+        "  --modulation-envelope-intensity <x>   0.2\n"
+        "  --modulation-duration <x>             6.0\n"
+        "  --lfo-frequency <x>                   0.5\n"
+        "  --lfo-amplitude <x>                   0.6\n"
+        "  --lfo-intensity <x>                   0.6\n"
+        "  --overtones <x>                       1.0\n"
+        "  --lfo-amount <x>                      1.0\n"
+        "  --order <name>                        raster, column, serpentine, spiral or hilbert (raster)\n"
+        "  --fm-depth-from <feature>             modulation depth follows an image feature (none)\n"
+        "  --overtones-from <feature>            overtone count follows an image feature (none)\n"
+        "  --lfo-rate-from <feature>             LFO speed follows an image feature (none)\n"
+        "\n"
+        "Each image produces one line of JSON with its outcome and the time spent\n"
+        "decoding, extracting features, synthesising and writing, in milliseconds.\n"
+        "\n"
+        "--sweep takes the generator's parameter names, e.g.\n"
+        "  --sweep \"lfo_intensity=0.2,0.4,0.8;overtone_num_scalar=1,2\"\n"
+        "Stages the variants have in common are rendered once.\n"
+        "\n"
+        "--sequence reads frames in natural order (frame_2 before frame_10). Each\n"
+        "frame lasts 1/fps seconds; --duration is ignored. Unless --no-incremental\n"
+        "is given, only the parts of a frame that changed are extracted again.\n"
+        "\n"
+        "Features are saturation, value, variance (of brightness) or edges.\n"
+        "\n"
+        "--daemon serves renders to every plugin instance on this machine until\n"
+        "the process is stopped.\n";
+
+    // Kernel and step sizes beyond this are rejected rather than cast
+    constexpr int maxWindowSize = 4096;
+
+    double parseNumber(const juce::String& text, const juce::String& context)
+    {
+        const auto trimmed = text.trim();
+        if (trimmed.isEmpty() || !trimmed.containsOnly("0123456789.-+eE"))
+            juce::ConsoleApplication::fail("Expected a number " + context);
+
+        // Most values end up in a float, so anything beyond one is out of range too
+        const double value = trimmed.getDoubleValue();
+        if (!std::isfinite(value) || std::abs(value) > std::numeric_limits<float>::max())
+            juce::ConsoleApplication::fail("Number out of range " + context);
+
+        return value;
+    }
+
+    double readNumber(const juce::ArgumentList& args, const char* option, double defaultValue)
+    {
+        if (!args.containsOption(option))
+            return defaultValue;
+
+        return parseNumber(args.getValueForOption(option), "after " + juce::String(option));
+    }
+
+    // Checked before the cast, since converting an out of range double to int is undefined
+    int checkInteger(double value, int minimum, int maximum, const juce::String& context)
+    {
+        if (!(value >= minimum && value <= maximum) || value != std::floor(value))
+            juce::ConsoleApplication::fail("Expected a whole number from " + juce::String(minimum) + " to "
+                                           + juce::String(maximum) + " " + context);
+
+        return (int)value;
+    }
+
+    int readInteger(const juce::ArgumentList& args, const char* option, int defaultValue, int minimum, int maximum)
+    {
+        if (!args.containsOption(option))
+            return defaultValue;
+
+        return checkInteger(readNumber(args, option, defaultValue), minimum, maximum, "after " + juce::String(option));
+    }
+
+    GenerationParameters readParameters(const juce::ArgumentList& args)
+    {
+        GenerationParameters params;
+
+        params.kernelSize = readInteger(args, "--kernel-size", params.kernelSize, 1, maxWindowSize);
+        params.stepSize = readInteger(args, "--step-size", params.stepSize, 1, maxWindowSize);
+        params.soundLevel = (float)readNumber(args, "--sound-level", params.soundLevel);
+        params.soundDuration = (float)readNumber(args, "--duration", params.soundDuration);
+        params.modulationIntensity = (float)readNumber(args, "--modulation-intensity", params.modulationIntensity);
+        params.modulationEnvelopeIntensity = (float)readNumber(args, "--modulation-envelope-intensity", params.modulationEnvelopeIntensity);
+        params.modulationDuration = (float)readNumber(args, "--modulation-duration", params.modulationDuration);
+        params.lfoScalarFreq = (float)readNumber(args, "--lfo-frequency", params.lfoScalarFreq);
+        params.lfoScalarAmplitude = (float)readNumber(args, "--lfo-amplitude", params.lfoScalarAmplitude);
+        params.lfoIntensity = (float)readNumber(args, "--lfo-intensity", params.lfoIntensity);
+        params.overtoneNumScalar = (float)readNumber(args, "--overtones", params.overtoneNumScalar);
+        params.lfoAmountScalar = (float)readNumber(args, "--lfo-amount", params.lfoAmountScalar);
+        params.sampleRate = readNumber(args, "--sample-rate", params.sampleRate);
+
+        if (args.containsOption("--order") && !WindowTraversal::fromName(args.getValueForOption("--order"), params.traversal))
+            juce::ConsoleApplication::fail("Unknown --order \"" + args.getValueForOption("--order") + "\"");
+
+        for (auto [option, source] : { std::make_pair("--fm-depth-from", &params.fmDepthSource),
+                                       std::make_pair("--overtones-from", &params.overtoneSource),
+                                       std::make_pair("--lfo-rate-from", &params.lfoRateSource) })
+        {
+            if (args.containsOption(option) && !ExtendedFeatureExtractor::fromName(args.getValueForOption(option), *source))
+                juce::ConsoleApplication::fail("Unknown " + juce::String(option) + " \"" + args.getValueForOption(option) + "\"");
+        }
+
+        if (params.kernelSize < 1 || params.stepSize < 1)
+            juce::ConsoleApplication::fail("Kernel and step size must be at least 1");
+
+        if (params.soundDuration <= 0.0f || params.sampleRate <= 0.0)
+            juce::ConsoleApplication::fail("Duration and sample rate must be positive");
+
+        return params;
+    }
+
+    std::vector<ParameterSweep::Axis> readSweep(const juce::ArgumentList& args)
+    {
+        std::vector<ParameterSweep::Axis> grid;
+
+        juce::StringArray axes;
+        axes.addTokens(args.getValueForOption("--sweep"), ";", "\"");
+        axes.removeEmptyStrings();
+
+        for (const auto& text : axes)
+        {
+            ParameterSweep::Axis axis{};
+
+            if (!ParameterSweep::fromName(text.upToFirstOccurrenceOf("=", false, false), axis.parameter))
+                juce::ConsoleApplication::fail("Unknown sweep parameter in \"" + text + "\"");
+
+            juce::StringArray values;
+            values.addTokens(text.fromFirstOccurrenceOf("=", false, false), ",", "");
+            values.trim();
+            values.removeEmptyStrings();
+
+            const bool isWindowSize = axis.parameter == ParameterSweep::Parameter::kernelSize
+                                   || axis.parameter == ParameterSweep::Parameter::stepSize;
+
+            for (const auto& value : values)
+            {
+                const double number = parseNumber(value, "in \"" + text + "\"");
+                axis.values.push_back(isWindowSize ? checkInteger(number, 1, maxWindowSize, "in \"" + text + "\"") : number);
+            }
+
+            if (axis.values.empty())
+                juce::ConsoleApplication::fail("No values in \"" + text + "\"");
+
+            grid.push_back(std::move(axis));
+        }
+
+        if (grid.empty())
+            juce::ConsoleApplication::fail("Expected name=values after --sweep");
+
+        return grid;
+    }
+
+    juce::String describeOutcome(BatchConverter::ItemReport::Outcome outcome)
+    {
+        switch (outcome)
+        {
+            case BatchConverter::ItemReport::Outcome::written:  return "written";
+            case BatchConverter::ItemReport::Outcome::upToDate: return "upToDate";
+            case BatchConverter::ItemReport::Outcome::failed:   break;
+        }
+
+        return "failed";
+    }
+
+    juce::String toJson(const BatchConverter::ItemReport& report)
+    {
+        auto* object = new juce::DynamicObject();
+        object->setProperty("image", report.image.getFullPathName());
+        object->setProperty("output", report.output == juce::File() ? juce::String() : report.output.getFullPathName());
+        object->setProperty("outcome", describeOutcome(report.outcome));
+        object->setProperty("featuresCached", report.featuresCached);
+        object->setProperty("kernelSize", report.kernelSize);
+        object->setProperty("stepSize", report.stepSize);
+        object->setProperty("decodeMs", report.decodeMs);
+        object->setProperty("featuresMs", report.featuresMs);
+        object->setProperty("synthesisMs", report.synthesisMs);
+        object->setProperty("writeMs", report.writeMs);
+        object->setProperty("totalMs", report.decodeMs + report.featuresMs + report.synthesisMs + report.writeMs);
+
+        return juce::JSON::toString(juce::var(object), true);
+    }
+
+    // One JSON line per image, with the folder the variants went to
+    int runSweep(const juce::Array<juce::File>& images, const std::string& outputPath, const GenerationParameters& params,
+                 const std::vector<ParameterSweep::Axis>& grid, const std::function<void(const juce::String&)>& writeLine)
+    {
+        const auto variants = ParameterSweep::expand(params, grid);
+        int failures = 0;
+
+        for (const auto& image : images)
+        {
+            const double started = juce::Time::getMillisecondCounterHiRes();
+
+            const auto rendered = ParameterSweep::render(image, variants, outputPath, [](float progress)
+                {
+                    std::cerr << "\r" << juce::roundToInt(progress * 100.0f) << "%   " << std::flush;
+                    return true;
+                });
+
+            const auto written = (int)std::count_if(rendered.begin(), rendered.end(),
+                                                    [](const ParameterSweep::Variant& v) { return v.file != juce::File(); });
+
+            if (written != (int)variants.size())
+                ++failures;
+
+            auto* object = new juce::DynamicObject();
+            object->setProperty("image", image.getFullPathName());
+            object->setProperty("folder", written == 0 ? juce::String() : ParameterSweep::getFolder(image, outputPath).getFullPathName());
+            object->setProperty("variants", (int)variants.size());
+            object->setProperty("written", written);
+            object->setProperty("totalMs", juce::Time::getMillisecondCounterHiRes() - started);
+
+            writeLine(juce::JSON::toString(juce::var(object), true));
+        }
+
+        std::cerr << "\r" << images.size() - failures << " of " << images.size() << " sweeps of "
+                  << (int)variants.size() << " variants rendered" << std::endl;
+
+        return failures == 0 ? 0 : 1;
+    }
+
+    // One JSON line for the whole sequence
+    int runSequence(const juce::File& folder, const juce::Array<juce::File>& frames, const juce::File& outputFolder,
+                    const GenerationParameters& params, const juce::ArgumentList& args,
+                    const std::function<void(const juce::String&)>& writeLine)
+    {
+        SequenceRenderer::Options options;
+        options.framesPerSecond = readNumber(args, "--fps", options.framesPerSecond);
+        options.incremental = !args.containsOption("--no-incremental");
+
+        if (options.framesPerSecond <= 0.0)
+            juce::ConsoleApplication::fail("--fps must be positive");
+
+        const juce::File output = outputFolder.getChildFile(folder.getFileName() + "_sequence.wav");
+        SequenceRenderer::Report report;
+
+        const bool written = SequenceRenderer::render(frames, output, params, options, &report, [](int done, int total)
+            {
+                std::cerr << "\r" << done << "/" << total << " frames" << std::flush;
+                return true;
+            });
+
+        auto* object = new juce::DynamicObject();
+        object->setProperty("folder", folder.getFullPathName());
+        object->setProperty("output", written ? output.getFullPathName() : juce::String());
+        object->setProperty("frames", frames.size());
+        object->setProperty("framesRendered", report.framesRendered);
+        object->setProperty("framesFailed", report.framesFailed);
+        object->setProperty("tilesRecomputed", report.tilesRecomputed);
+        object->setProperty("tilesTotal", report.tilesTotal);
+        object->setProperty("totalMs", report.seconds * 1000.0);
+
+        writeLine(juce::JSON::toString(juce::var(object), true));
+
+        std::cerr << "\r" << report.framesRendered << " of " << frames.size() << " frames rendered in "
+                  << juce::String(report.seconds, 2) << " s" << std::endl;
+
+        return written && report.framesFailed == 0 ? 0 : 1;
+    }
+
+    int runDaemon(const juce::ArgumentList& args)
+    {
+        const int workers = readInteger(args, "--workers", juce::SystemStats::getNumCpus(), 1, 1024);
+
+        GenerationDaemon daemon(workers);
+        if (!daemon.start())
+            juce::ConsoleApplication::fail("Could not start the daemon; is one already running?");
+
+        std::cerr << "Serving " << DaemonProtocol::getRuntimeFolder().getFullPathName() << " with " << workers << " workers" << std::endl;
+
+        juce::WaitableEvent forever;
+        forever.wait();
+        return 0;
+    }
+
+    int render(const juce::ArgumentList& args)
+    {
+        if (args.size() == 0 || args.containsOption("--help|-h"))
+        {
+            std::cout << usage;
+            return 0;
+        }
+
+        if (args.containsOption("--daemon"))
+            return runDaemon(args);
+
+        if (args[0].isOption())
+            juce::ConsoleApplication::fail(juce::String("The image or folder comes first\n\n") + usage);
+
+        const juce::File source = args[0].resolveAsFile();
+        const GenerationParameters params = readParameters(args);
+
+        juce::Array<juce::File> images;
+
+        if (source.isDirectory() && args.containsOption("--sequence"))
+        {
+            images = SequenceRenderer::findFrames(source);
+        }
+        else if (source.isDirectory())
+        {
+            for (const auto& file : source.findChildFiles(juce::File::findFiles, false))
+                if (ImageLoader::isSupportedImage(file))
+                    images.add(file);
+
+            images.sort();
+        }
+        else if (source.existsAsFile() && ImageLoader::isSupportedImage(source))
+        {
+            images.add(source);
+        }
+        else
+        {
+            juce::ConsoleApplication::fail("Not an image or folder: " + source.getFullPathName());
+        }
+
+        const juce::File outputFolder = args.containsOption("--output")
+            ? args.getFileForOption("--output")
+            : juce::File::getCurrentWorkingDirectory().getChildFile("output");
+
+        if (!outputFolder.isDirectory() && !outputFolder.createDirectory())
+            juce::ConsoleApplication::fail("Could not create " + outputFolder.getFullPathName());
+
+        std::unique_ptr<juce::FileOutputStream> reportFile;
+
+        if (args.containsOption("--report"))
+        {
+            const juce::File reportPath = args.getFileForOption("--report");
+            reportPath.deleteFile();
+
+            reportFile = std::make_unique<juce::FileOutputStream>(reportPath);
+            if (reportFile->failedToOpen())
+                juce::ConsoleApplication::fail("Could not write " + reportPath.getFullPathName());
+        }
+
+        auto writeLine = [&reportFile](const juce::String& line)
+        {
+            if (reportFile != nullptr)
+            {
+                reportFile->writeText(line + "\n", false, false, nullptr);
+                reportFile->flush();
+            }
+            else
+            {
+                std::cout << line << std::endl;
+            }
+        };
+
+        const std::string outputPath = (outputFolder.getFullPathName() + juce::File::getSeparatorString()).toStdString();
+
+        if (args.containsOption("--sequence"))
+        {
+            if (!source.isDirectory() || images.isEmpty())
+                juce::ConsoleApplication::fail("--sequence needs a folder of frames");
+
+            return runSequence(source, images, outputFolder, params, args, writeLine);
+        }
+
+        if (args.containsOption("--sweep"))
+            return runSweep(images, outputPath, params, readSweep(args), writeLine);
+
+        auto options = BatchConverter::Options::forThisMachine();
+
+        if (args.containsOption("--auto-resolution"))
+        {
+            const auto value = args.getValueForOption("--auto-resolution");
+            options.autoResolutionFeatures = value.isEmpty() || value.startsWithChar('-')
+                ? AutoResolution::defaultMaxFeatures
+                : readInteger(args, "--auto-resolution", AutoResolution::defaultMaxFeatures, 1, std::numeric_limits<int>::max());
+        }
+
+        int failures = 0;
+
+        BatchConverter converter(options);
+        converter.onItemFinished = [&](const BatchConverter::ItemReport& report)
+        {
+            if (report.outcome == BatchConverter::ItemReport::Outcome::failed)
+                ++failures;
+
+            writeLine(toJson(report));
+        };
+
+        const double started = juce::Time::getMillisecondCounterHiRes();
+
+        converter.run(images, outputPath, params, [](int done, int total)
+            {
+                std::cerr << "\r" << done << "/" << total << " images" << std::flush;
+                return true;
+            });
+
+        const double seconds = (juce::Time::getMillisecondCounterHiRes() - started) / 1000.0;
+        std::cerr << "\r" << images.size() - failures << " of " << images.size() << " images rendered in "
+                  << juce::String(seconds, 2) << " s" << std::endl;
+
+        return failures == 0 ? 0 : 1;
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    const juce::ArgumentList args(argc, argv);
+
+    return juce::ConsoleApplication::invokeCatchingFailures([&args]
+        {
+            return render(args);
+        });
+}
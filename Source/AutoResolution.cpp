@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    AutoResolution.cpp
+    Created: 18 Oct 2026 7:23:31am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#include "AutoResolution.h"
+#include "ImageLoader.h"
+#include <limits>
+
+namespace
+{
+    // About 25 / 10, the default kernel and step, rounded to a multiple of the
+    // step's power-of-two factor so ImageLoader::chooseScale can downscale
+    int kernelForStep(int stepSize, int width, int height)
+    {
+        const int factor = juce::jmin(8, stepSize & -stepSize);
+        const int limit = juce::jmin(AutoResolution::maxKernelSize, width, height);
+
+        int kernelSize = ((stepSize * 5 + factor) / (2 * factor)) * factor;
+        if (kernelSize > limit)
+            kernelSize = limit / factor * factor;
+
+        return juce::jlimit(1, juce::jmax(1, limit), kernelSize);
+    }
+}
+
+int AutoResolution::countWindows(int width, int height, int kernelSize, int stepSize)
+{
+    if (kernelSize <= 0 || stepSize <= 0 || kernelSize > width || kernelSize > height)
+        return 0;
+
+    const int64_t windows = (int64_t)((height - kernelSize) / stepSize + 1) * (int64_t)((width - kernelSize) / stepSize + 1);
+    return (int)juce::jmin(windows, (int64_t)std::numeric_limits<int>::max());
+}
+
+AutoResolution::Choice AutoResolution::choose(int width, int height, double durationSeconds, double sampleRate,
+                                              int maxFeatures)
+{
+    const double samples = juce::jmax(0.0, durationSeconds * sampleRate);
+    const int target = juce::jmax(1, (int)juce::jmin((double)maxFeatures, samples / minSamplesPerFeature));
+
+    Choice choice;
+
+    // At most 50 candidates, each a division, so this is cheap enough to run per slider move
+    for (int step = 1; step <= maxStepSize; ++step)
+    {
+        choice.stepSize = step;
+        choice.kernelSize = kernelForStep(step, width, height);
+        choice.numFeatures = countWindows(width, height, choice.kernelSize, step);
+
+        if (choice.numFeatures <= target)
+            break;
+    }
+
+    return choice;
+}
+
+bool AutoResolution::readProcessedSize(const juce::File& imageFile, int& width, int& height)
+{
+    return ImageLoader::readSize(imageFile, width, height);
+}
+
+bool AutoResolution::choose(const juce::File& imageFile, double durationSeconds, double sampleRate,
+                            Choice& choice, int maxFeatures)
+{
+    int width = 0, height = 0;
+    if (!readProcessedSize(imageFile, width, height))
+        return false;
+
+    choice = choose(width, height, durationSeconds, sampleRate, maxFeatures);
+    return true;
+}
@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    AutoResolution.h
+    Created: 18 Oct 2026 7:23:31am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Picks kernel and step size from the image instead of the sliders.
+
+    Extraction cost and the length of the feature arrays both grow with
+    (width / step) x (height / step), so a fixed step that suits a thumbnail
+    produces millions of windows on a 4K photo. Here the step is the smallest
+    one that keeps the window count within a budget, and within one window
+    per minSamplesPerFeature samples of output: beyond that the synthesis
+    only interpolates between features it can't resolve anyway. The kernel
+    keeps the default 25 / 10 overlap.
+
+    Generation time then depends on the duration, not on the input size.
+*/
+class AutoResolution
+{
+public:
+    struct Choice
+    {
+        int kernelSize = 25;
+        int stepSize = 10;
+        int numFeatures = 0;    // windows computeBlockMeans will produce
+    };
+
+    static constexpr int defaultMaxFeatures = 20000;
+    static constexpr double minSamplesPerFeature = 16.0;
+
+    // The sliders' range
+    static constexpr int maxKernelSize = 50;
+    static constexpr int maxStepSize = 50;
+
+    static Choice choose(int width, int height, double durationSeconds, double sampleRate,
+                         int maxFeatures = defaultMaxFeatures);
+
+    // The size features will be computed at, from the image header alone. ImageLoader
+    // and TiledImageReader both work at the native size, so this is the header's size;
+    // anything choosing a resolution goes through here in case that changes.
+    // False if it isn't a PNG or JPEG with a readable header.
+    static bool readProcessedSize(const juce::File& imageFile, int& width, int& height);
+
+    // Reads just the image header. False if it isn't a PNG or JPEG with a readable one.
+    static bool choose(const juce::File& imageFile, double durationSeconds, double sampleRate,
+                       Choice& choice, int maxFeatures = defaultMaxFeatures);
+
+    // Same count as IntegralImage::computeBlockMeans; 0 if the kernel doesn't fit
+    static int countWindows(int width, int height, int kernelSize, int stepSize);
+};
@@ -0,0 +1,541 @@
+/*
+  ==============================================================================
+
+    BatchConverter.cpp
+    Created: 18 Oct 2026 7:07:59am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#include "BatchConverter.h"
+#include "AutoResolution.h"
+#include "BatchManifest.h"
+#include "BoundedQueue.h"
+#include "ExtendedFeatures.h"
+#include "FeatureCache.h"
+#include "ImageLoader.h"
+#include "ImageFeatures.h"
+#include "TiledImageReader.h"
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+
+namespace
+{
+    // One image on its way through the pipeline. Each stage frees what the
+    // next ones don't need, so an item only ever holds one large payload.
+    struct BatchItem
+    {
+        int index = 0;
+        juce::File imageFile;
+        juce::String outputStem;        // unique within the batch, see makeOutputStems
+        juce::int64 imageSize = 0, imageModified = 0;
+        juce::String imageHash;
+        juce::String previousOutput;    // from the manifest, replaced by this run's file
+        GenerationParameters params;    // the batch's, with kernel and step chosen per image in auto resolution
+        juce::String paramsKey;
+        PlanarImage image;
+
+        std::unique_ptr<FeatureCache::Entry> cachedFeatures;
+        ImageFeatures computedFeatures;
+        FeatureChannels features;
+
+        // Synthesis streams into partial, which the write stage renames to output.
+        // An item dropped on the way takes its partial file with it.
+        juce::File output, partial;
+
+        BatchConverter::ItemReport report;
+
+        ~BatchItem()
+        {
+            if (partial != juce::File())
+                partial.deleteFile();
+        }
+    };
+
+    using ItemPtr = std::unique_ptr<BatchItem>;
+
+    double millisecondsSince(double start)
+    {
+        return juce::Time::getMillisecondCounterHiRes() - start;
+    }
+
+    // Where a WAV is written before being renamed into place, so anything
+    // watching the output folder never sees a half-written file
+    juce::File getPartialFile(const juce::File& file)
+    {
+        return file.getSiblingFile("." + file.getFileName() + ".part");
+    }
+
+    // A 16 bit WAV writer on file's partial file, creating the folder if needed
+    std::unique_ptr<juce::AudioFormatWriter> createPartialWriter(const juce::File& file, double sampleRate, int numChannels)
+    {
+        if (!file.getParentDirectory().exists() && !file.getParentDirectory().createDirectory())
+        {
+            DBG("Error: Failed to create directory: " << file.getParentDirectory().getFullPathName());
+            return nullptr;
+        }
+
+        const juce::File partial = getPartialFile(file);
+        partial.deleteFile();
+
+        juce::WavAudioFormat wavFormat;
+        std::unique_ptr<juce::FileOutputStream> outputStream(partial.createOutputStream());
+        if (outputStream == nullptr)
+            return nullptr;
+
+        std::unique_ptr<juce::AudioFormatWriter> writer(wavFormat.createWriterFor(outputStream.get(),
+            sampleRate,
+            (unsigned int)numChannels,
+            16,
+            {},
+            0));
+
+        if (writer == nullptr)
+        {
+            DBG("Error Creating WAV File Writer!");
+            outputStream.reset();
+            partial.deleteFile();
+            return nullptr;
+        }
+
+        // The writer owns the stream from here on, and finishes the header when it goes
+        outputStream.release();
+        return writer;
+    }
+
+    // The {image} part of each output name, in input order. Images sharing a stem
+    // (photo.jpg and photo.png, say) keep their extension in it, and anything still
+    // clashing gets a counter, so parallel workers never write the same file.
+    std::vector<juce::String> makeOutputStems(const juce::Array<juce::File>& images)
+    {
+        std::map<juce::String, int> stemCounts;
+        for (const auto& image : images)
+            ++stemCounts[image.getFileNameWithoutExtension().toLowerCase()];
+
+        std::vector<juce::String> stems;
+        std::set<juce::String> used;    // lower case, since output folders may be case-insensitive
+
+        for (const auto& image : images)
+        {
+            juce::String stem = image.getFileNameWithoutExtension();
+            if (stemCounts[stem.toLowerCase()] > 1)
+                stem << "_" << image.getFileExtension().trimCharactersAtStart(".");
+
+            juce::String unique = stem;
+            for (int n = 2; !used.insert(unique.toLowerCase()).second; ++n)
+                unique = stem + "_" + juce::String(n);
+
+            stems.push_back(unique);
+        }
+
+        return stems;
+    }
+}
+
+BatchConverter::Options BatchConverter::Options::forThisMachine()
+{
+    const int cores = juce::jmax(1, juce::SystemStats::getNumCpus());
+
+    Options result;
+    result.decodeWorkers = juce::jlimit(1, 4, cores / 4);
+    result.synthesisWorkers = juce::jmax(1, cores - result.decodeWorkers - 1);
+    return result;
+}
+
+BatchConverter::BatchConverter(const Options& o)
+    : options(o)
+{
+}
+
+bool BatchConverter::writeWavFile(const juce::AudioBuffer<float>& sound, const juce::File& file, double sampleRate)
+{
+    auto writer = createPartialWriter(file, sampleRate, sound.getNumChannels());
+    if (writer == nullptr)
+        return false;
+
+    const bool written = writer->writeFromAudioSampleBuffer(sound, 0, sound.getNumSamples());
+    writer.reset();     // finishes the header before the rename
+
+    const juce::File partial = getPartialFile(file);
+
+    if (!written || !partial.moveFileTo(file))
+    {
+        partial.deleteFile();
+        return false;
+    }
+
+    return true;
+}
+
+std::vector<juce::File> BatchConverter::run(const juce::Array<juce::File>& images, const std::string& outputPath,
+                                            const GenerationParameters& params, const ProgressCallback& onProgress)
+{
+    const int total = images.size();
+    std::vector<juce::File> written((size_t)total);
+
+    if (total == 0)
+        return written;
+
+    FeatureCache cache;
+    BatchManifest manifest(juce::File(outputPath + "manifest.jsonl"));
+    const auto outputStems = makeOutputStems(images);
+
+    const auto capacity = (size_t)juce::jmax(1, options.queueCapacity);
+    BoundedQueue<ItemPtr> decoded(capacity), extracted(capacity), synthesised(capacity);
+
+    std::atomic<int> nextImage{ 0 }, filesDone{ 0 };
+    std::atomic<bool> stopping{ false };
+    std::mutex progressLock;
+
+    auto stop = [&]
+    {
+        stopping = true;
+        decoded.close();
+        extracted.close();
+        synthesised.close();
+    };
+
+    // Polled between images and between render blocks, so a stop takes effect mid-image
+    auto isStopping = [&]
+    {
+        if (!stopping && shouldStop != nullptr && shouldStop())
+            stop();
+
+        return stopping.load();
+    };
+
+    // Every image ends here, whether it was written or dropped along the way
+    auto finishItem = [&](const ItemReport& report)
+    {
+        const int done = ++filesDone;
+        std::lock_guard<std::mutex> lock(progressLock);
+
+        if (onItemFinished != nullptr)
+            onItemFinished(report);
+
+        if (onProgress != nullptr && !stopping && !onProgress(done, total))
+            stop();
+    };
+
+    auto decode = [&]
+    {
+        while (!isStopping())
+        {
+            const int index = nextImage++;
+            if (index >= total)
+                break;
+
+            const double started = juce::Time::getMillisecondCounterHiRes();
+
+            auto item = std::make_unique<BatchItem>();
+            item->index = index;
+            item->imageFile = images[index];
+            item->outputStem = outputStems[(size_t)index];
+            item->report.image = item->imageFile;
+            item->imageSize = item->imageFile.getSize();
+            item->imageModified = item->imageFile.getLastModificationTime().toMilliseconds();
+            item->params = params;
+
+            AutoResolution::Choice choice;
+            if (options.autoResolutionFeatures > 0
+                && AutoResolution::choose(item->imageFile, params.soundDuration, params.sampleRate, choice, options.autoResolutionFeatures))
+            {
+                item->params.kernelSize = choice.kernelSize;
+                item->params.stepSize = choice.stepSize;
+            }
+
+            item->paramsKey = BatchManifest::describe(item->params);
+            item->report.kernelSize = item->params.kernelSize;
+            item->report.stepSize = item->params.stepSize;
+
+            // Skip images the manifest already has a current file for. An unchanged
+            // size and date is trusted; otherwise the content hash decides.
+            auto previous = manifest.find(item->imageFile);
+            const bool outputCurrent = previous && previous->params == item->paramsKey && juce::File(previous->output).existsAsFile();
+
+            auto skip = [&]
+            {
+                written[(size_t)index] = juce::File(previous->output);
+
+                item->report.output = written[(size_t)index];
+                item->report.outcome = ItemReport::Outcome::upToDate;
+                item->report.decodeMs = millisecondsSince(started);
+                finishItem(item->report);
+            };
+
+            if (outputCurrent && previous->size == item->imageSize && previous->modified == item->imageModified)
+            {
+                skip();
+                continue;
+            }
+
+            // Read once: the same bytes are hashed and, on a cache miss, decoded. Images
+            // too large to decode whole are hashed from the file and read in strips.
+            const bool tiled = TiledImageReader::shouldUse(item->imageFile);
+            juce::MemoryBlock fileData;
+
+            if (tiled || !item->imageFile.loadFileAsData(fileData))
+                item->imageHash = FeatureCache::hashImage(item->imageFile);
+            else
+                item->imageHash = FeatureCache::hashImage(fileData);
+
+            if (outputCurrent && previous->hash == item->imageHash)
+            {
+                auto entry = *previous;
+                entry.size = item->imageSize;
+                entry.modified = item->imageModified;
+                manifest.record(entry);
+
+                skip();
+                continue;
+            }
+
+            if (previous)
+                item->previousOutput = previous->output;
+
+            // A cache hit goes straight through the extraction stage. Feature mappings need
+            // an entry that carries the extended channels too.
+            item->cachedFeatures = cache.find(item->imageHash, item->params.kernelSize, item->params.stepSize,
+                                              item->params.traversal, item->params.needsExtendedFeatures());
+
+            if (item->cachedFeatures != nullptr)
+            {
+                item->features = item->cachedFeatures->getChannels();
+                item->report.featuresCached = true;
+            }
+            else if (tiled)
+            {
+                // Too large to decode whole, so the features come straight out of the file
+                try
+                {
+                    item->computedFeatures = TiledImageReader::computeBlockMeans(item->imageFile, item->params.kernelSize,
+                        item->params.stepSize, item->params.traversal, [&isStopping](float) { return !isStopping(); });
+                }
+                catch (const std::exception& e)
+                {
+                    juce::ignoreUnused(e);
+                    DBG("Feature extraction failed: " << e.what());
+                }
+
+                if (item->computedFeatures.isEmpty())
+                {
+                    item->report.decodeMs = millisecondsSince(started);
+                    finishItem(item->report);
+                    continue;
+                }
+
+                item->features = item->computedFeatures.getChannels();
+                cache.store(item->imageHash, item->params.kernelSize, item->params.stepSize, item->computedFeatures, item->params.traversal);
+            }
+            else
+            {
+                item->image = fileData.isEmpty()
+                    ? ImageLoader::load(item->imageFile, item->params.kernelSize, item->params.stepSize)
+                    : ImageLoader::load(fileData, item->params.kernelSize, item->params.stepSize);
+
+                if (item->image.isEmpty())
+                {
+                    DBG("Could not decode image: " << item->imageFile.getFullPathName());
+                    item->report.decodeMs = millisecondsSince(started);
+                    finishItem(item->report);
+                    continue;
+                }
+            }
+
+            item->report.decodeMs = millisecondsSince(started);
+
+            if (!decoded.push(std::move(item)))
+                break;
+        }
+    };
+
+    auto extract = [&]
+    {
+        ItemPtr item;
+        while (!isStopping() && decoded.pop(item))
+        {
+            const double started = juce::Time::getMillisecondCounterHiRes();
+
+            if (item->features.isEmpty())
+            {
+                try
+                {
+                    if (item->params.needsExtendedFeatures())
+                    {
+                        item->computedFeatures = ExtendedFeatureExtractor::compute(item->image, item->params.kernelSize,
+                                                                                   item->params.stepSize, item->params.traversal);
+                    }
+                    else
+                    {
+                        IntegralImage integral;
+                        integral.build(item->image);
+                        item->computedFeatures = integral.computeBlockMeans(item->params.kernelSize, item->params.stepSize,
+                                                                            item->params.traversal);
+                    }
+
+                    item->features = item->computedFeatures.getChannels();
+
+                    cache.store(item->imageHash, item->params.kernelSize, item->params.stepSize, item->computedFeatures,
+                                item->params.traversal);
+                }
+                catch (const std::exception& e)
+                {
+                    juce::ignoreUnused(e);
+                    DBG("Feature extraction failed: " << e.what());
+                }
+
+                item->image = {};
+            }
+
+            item->report.featuresMs = millisecondsSince(started);
+
+            if (item->features.isEmpty())
+            {
+                finishItem(item->report);
+                continue;
+            }
+
+            if (!extracted.push(std::move(item)))
+                break;
+        }
+    };
+
+    // Renders straight into the WAV's partial file a block at a time, so no
+    // item ever holds a whole sound
+    auto synthesise = [&]
+    {
+        ImageSynthEngine engine;
+        std::vector<float> block((size_t)ImageSynthEngine::defaultBlockSize);
+        const float* channels[] = { block.data() };
+
+        ItemPtr item;
+        while (!isStopping() && extracted.pop(item))
+        {
+            const double started = juce::Time::getMillisecondCounterHiRes();
+            bool rendered = false;
+
+            if (engine.prepare(item->features, item->params))
+            {
+                item->output = juce::File(outputPath + item->outputStem.toStdString()
+                    + "_output_" + engine.getDominantColour().toStdString() + ".wav");
+                item->partial = getPartialFile(item->output);
+
+                // Going out of scope finishes the header, before the write stage renames the file
+                if (auto writer = createPartialWriter(item->output, item->params.sampleRate, 1))
+                {
+                    rendered = true;
+
+                    while (rendered && !engine.isFinished())
+                    {
+                        const int numSamples = engine.renderNextBlock(block.data(), (int)block.size());
+                        rendered = numSamples > 0 && !isStopping() && writer->writeFromFloatArrays(channels, 1, numSamples);
+                    }
+                }
+            }
+
+            item->features = {};
+            item->cachedFeatures.reset();
+            item->computedFeatures = {};
+            item->report.synthesisMs = millisecondsSince(started);
+
+            if (!rendered)
+            {
+                if (!stopping)
+                    DBG("Could not render " << item->imageFile.getFullPathName());
+                finishItem(item->report);
+                continue;
+            }
+
+            if (!synthesised.push(std::move(item)))
+                break;
+        }
+    };
+
+    auto write = [&]
+    {
+        ItemPtr item;
+        while (!isStopping() && synthesised.pop(item))
+        {
+            const double started = juce::Time::getMillisecondCounterHiRes();
+            const juce::File file = item->output;
+
+            if (item->partial.moveFileTo(file))
+            {
+                item->partial = juce::File();
+                written[(size_t)item->index] = file;
+                item->report.output = file;
+                item->report.outcome = ItemReport::Outcome::written;
+
+                // The dominant colour is part of the name, so an edited image can leave a stale file behind
+                if (item->previousOutput.isNotEmpty() && juce::File(item->previousOutput) != file)
+                    juce::File(item->previousOutput).deleteFile();
+
+                manifest.record({ item->imageFile.getFullPathName(), item->imageSize, item->imageModified,
+                                  item->imageHash, item->paramsKey, file.getFullPathName() });
+            }
+            else
+            {
+                DBG("Could not write " << file.getFullPathName());
+            }
+
+            item->report.writeMs = millisecondsSince(started);
+            finishItem(item->report);
+            item.reset();
+        }
+    };
+
+    // The last worker of a stage to finish closes the queue it feeds, which lets
+    // the next stage drain it and finish in turn
+    std::vector<std::thread> threads;
+
+    auto startStage = [&threads, &stop](int numWorkers, const std::function<void()>& work, BoundedQueue<ItemPtr>* output)
+    {
+        numWorkers = juce::jmax(1, numWorkers);
+        auto remaining = std::make_shared<std::atomic<int>>(numWorkers);
+
+        for (int i = 0; i < numWorkers; ++i)
+        {
+            threads.emplace_back([&work, &stop, output, remaining]
+                {
+                    // An exception escaping a std::thread would terminate the process,
+                    // so it stops the batch instead
+                    try
+                    {
+                        work();
+                    }
+                    catch (const std::exception& e)
+                    {
+                        juce::ignoreUnused(e);
+                        DBG("Batch conversion failed: " << e.what());
+                        stop();
+                    }
+                    catch (...)
+                    {
+                        DBG("Batch conversion failed");
+                        stop();
+                    }
+
+                    if (--*remaining == 0 && output != nullptr)
+                        output->close();
+                });
+        }
+    };
+
+    const std::function<void()> stages[] = { decode, extract, synthesise, write };
+
+    startStage(options.decodeWorkers, stages[0], &decoded);
+    startStage(options.featureWorkers, stages[1], &extracted);
+    startStage(options.synthesisWorkers, stages[2], &synthesised);
+    startStage(options.writeWorkers, stages[3], nullptr);
+
+    for (auto& thread : threads)
+        thread.join();
+
+    manifest.compact();
+    return written;
+}
@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+
+    BatchConverter.h
+    Created: 18 Oct 2026 7:07:59am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "ImageSynthEngine.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+//==============================================================================
+/**
+    Converts a folder's worth of images to WAV files as a four stage pipeline:
+
+        decode -> extract features -> synthesise -> write
+
+    Stages run on their own worker threads and hand items on through bounded
+    queues, so every core stays busy while only a few images are in flight:
+    at most queueCapacity items wait between two stages, plus one per worker.
+    Images found in the FeatureCache skip decoding and extraction. Synthesis
+    streams each sound into a hidden partial file block by block, and the
+    write stage renames it into place, so no stage holds a whole sound.
+
+    Finished files are recorded in a BatchManifest in the output folder.
+    Images whose content and parameters match an entry whose file still
+    exists are skipped, so re-runs only convert what changed and an
+    interrupted batch picks up where it stopped.
+*/
+class BatchConverter
+{
+public:
+    struct Options
+    {
+        int decodeWorkers = 1;
+        int featureWorkers = 1;         // extraction is already parallel inside each image
+        int synthesisWorkers = 1;
+        int writeWorkers = 1;
+        int queueCapacity = 2;
+
+        // If > 0, each image gets its own kernel and step from AutoResolution, within this many windows
+        int autoResolutionFeatures = 0;
+
+        // Spreads the machine's cores over the stages, most of them to synthesis
+        static Options forThisMachine();
+    };
+
+    // Called from worker threads, one call at a time, after each file is written
+    // or skipped. Return false to stop the batch.
+    using ProgressCallback = std::function<bool(int filesDone, int filesTotal)>;
+
+    // What happened to one image, and how long each stage spent on it
+    struct ItemReport
+    {
+        enum class Outcome { written, upToDate, failed };
+
+        juce::File image, output;
+        Outcome outcome = Outcome::failed;
+        bool featuresCached = false;
+        int kernelSize = 0, stepSize = 0;  // as used, which auto resolution may have chosen
+        double decodeMs = 0.0, featuresMs = 0.0, synthesisMs = 0.0, writeMs = 0.0;
+    };
+
+    explicit BatchConverter(const Options& options = Options::forThisMachine());
+
+    // Blocks until every image is converted or the batch is stopped. Returns the
+    // output files in input order, including ones that were already up to date,
+    // with an empty File for images that failed.
+    // Files are named {outputPath}{image}_output_{colour}.wav, as generate_sound does.
+    // Images sharing a name apart from the extension keep it: photo_jpg_output_{colour}.wav.
+    std::vector<juce::File> run(const juce::Array<juce::File>& images, const std::string& outputPath,
+                                const GenerationParameters& params, const ProgressCallback& onProgress = nullptr);
+
+    // 16 bit WAV, creating the parent folder if needed. The file appears in one rename.
+    static bool writeWavFile(const juce::AudioBuffer<float>& sound, const juce::File& file, double sampleRate);
+
+    // Called from worker threads, one call at a time, as each image leaves the pipeline
+    std::function<void(const ItemReport&)> onItemFinished;
+
+    // Polled from every worker thread between images and between render blocks;
+    // return true to stop the batch. Unlike the progress callback, this takes
+    // effect in the middle of an image.
+    std::function<bool()> shouldStop;
+
+private:
+    Options options;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BatchConverter)
+};
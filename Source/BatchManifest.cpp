@@ -0,0 +1,133 @@
+/*
+  ==============================================================================
+
+    BatchManifest.cpp
+    Created: 18 Oct 2026 7:08:49am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#include "BatchManifest.h"
+#include "ExtendedFeatures.h"
+
+BatchManifest::BatchManifest(const juce::File& manifestFile)
+    : file(manifestFile)
+{
+    juce::StringArray lines;
+    file.readLines(lines);
+
+    for (const auto& line : lines)
+    {
+        if (line.trim().isEmpty())
+            continue;
+
+        // A line cut short by a crash simply doesn't parse and is ignored
+        const juce::var parsed = juce::JSON::parse(line);
+        if (!parsed.isObject())
+            continue;
+
+        Entry entry;
+        entry.source = parsed["source"].toString();
+        entry.size = (juce::int64)parsed["size"];
+        entry.modified = (juce::int64)parsed["modified"];
+        entry.hash = parsed["hash"].toString();
+        entry.params = parsed["params"].toString();
+        entry.output = parsed["output"].toString();
+
+        if (entry.source.isNotEmpty())
+        {
+            entries[entry.source] = entry;
+            ++numLines;
+        }
+    }
+}
+
+juce::String BatchManifest::describe(const GenerationParameters& params)
+{
+    return "v" + juce::String(generatorVersion)
+        + " k" + juce::String(params.kernelSize)
+        + " s" + juce::String(params.stepSize)
+        + " level" + juce::String(params.soundLevel)
+        + " dur" + juce::String(params.soundDuration)
+        + " mi" + juce::String(params.modulationIntensity)
+        + " mei" + juce::String(params.modulationEnvelopeIntensity)
+        + " md" + juce::String(params.modulationDuration)
+        + " lf" + juce::String(params.lfoScalarFreq)
+        + " la" + juce::String(params.lfoScalarAmplitude)
+        + " li" + juce::String(params.lfoIntensity)
+        + " ot" + juce::String(params.overtoneNumScalar)
+        + " ln" + juce::String(params.lfoAmountScalar)
+        + " sr" + juce::String(params.sampleRate)
+        // Only named when it isn't raster, so manifests from before it existed still match
+        + (params.traversal == TraversalOrder::raster ? juce::String() : " " + WindowTraversal::getName(params.traversal))
+        // Likewise for the feature mappings
+        + (params.fmDepthSource == FeatureSource::none ? juce::String() : " fm:" + ExtendedFeatureExtractor::getName(params.fmDepthSource))
+        + (params.overtoneSource == FeatureSource::none ? juce::String() : " ot:" + ExtendedFeatureExtractor::getName(params.overtoneSource))
+        + (params.lfoRateSource == FeatureSource::none ? juce::String() : " lr:" + ExtendedFeatureExtractor::getName(params.lfoRateSource));
+}
+
+juce::String BatchManifest::toLine(const Entry& entry)
+{
+    auto* object = new juce::DynamicObject();
+    object->setProperty("source", entry.source);
+    object->setProperty("size", entry.size);
+    object->setProperty("modified", entry.modified);
+    object->setProperty("hash", entry.hash);
+    object->setProperty("params", entry.params);
+    object->setProperty("output", entry.output);
+
+    return juce::JSON::toString(juce::var(object), true);
+}
+
+std::optional<BatchManifest::Entry> BatchManifest::find(const juce::File& source) const
+{
+    std::lock_guard<std::mutex> sl(lock);
+
+    auto it = entries.find(source.getFullPathName());
+    if (it == entries.end())
+        return std::nullopt;
+
+    return it->second;
+}
+
+void BatchManifest::record(const Entry& entry)
+{
+    std::lock_guard<std::mutex> sl(lock);
+
+    entries[entry.source] = entry;
+
+    if (log == nullptr)
+    {
+        file.getParentDirectory().createDirectory();
+        log = std::make_unique<juce::FileOutputStream>(file);     // appends to what's there
+
+        if (log->failedToOpen())
+        {
+            log.reset();
+            return;
+        }
+    }
+
+    log->writeText(toLine(entry) + "\n", false, false, nullptr);
+    log->flush();
+    ++numLines;
+}
+
+void BatchManifest::compact()
+{
+    std::lock_guard<std::mutex> sl(lock);
+
+    if (numLines <= (int)entries.size())
+        return;
+
+    log.reset();
+
+    juce::String text;
+    for (const auto& [source, entry] : entries)
+        text << toLine(entry) << "\n";
+
+    juce::TemporaryFile temp(file);
+    if (temp.getFile().replaceWithText(text, false, false, nullptr) && temp.overwriteTargetFileWithTemporary())
+        numLines = (int)entries.size();
+}
@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+    BatchManifest.h
+    Created: 18 Oct 2026 7:08:49am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "ImageSynthEngine.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+//==============================================================================
+/**
+    Record of what a batch conversion has produced, kept as manifest.jsonl in
+    the output folder: one JSON object per line with the source image, its
+    size, modification time and content hash, the generation parameters and
+    the file written.
+
+    Lines are appended and flushed as each file is finished, so a batch that
+    is interrupted resumes where it stopped; later lines for the same source
+    replace earlier ones. compact() rewrites the file with one line per source.
+*/
+class BatchManifest
+{
+public:
+    struct Entry
+    {
+        juce::String source;        // full path of the image
+        juce::int64 size = 0;
+        juce::int64 modified = 0;   // milliseconds since the epoch
+        juce::String hash;          // FeatureCache::hashImage
+        juce::String params;        // describe(params)
+        juce::String output;        // full path of the WAV
+    };
+
+    explicit BatchManifest(const juce::File& manifestFile);
+
+    // Thread safe
+    std::optional<Entry> find(const juce::File& source) const;
+    void record(const Entry& entry);
+
+    // Rewrites the file without superseded lines
+    void compact();
+
+    // Every input that affects the output, including the generator version
+    static juce::String describe(const GenerationParameters& params);
+
+    static constexpr int generatorVersion = 3;     // bump when the native output changes
+
+private:
+    static juce::String toLine(const Entry& entry);
+
+    juce::File file;
+    std::map<juce::String, Entry> entries;
+    int numLines = 0;
+    std::unique_ptr<juce::FileOutputStream> log;
+    mutable std::mutex lock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BatchManifest)
+};
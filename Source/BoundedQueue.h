@@ -0,0 +1,69 @@
+/*
+  ==============================================================================
+
+    BoundedQueue.h
+    Created: 18 Oct 2026 7:07:59am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+// Blocking FIFO with a fixed capacity, for handing work between pipeline stages.
+// push() waits while the queue is full and pop() while it is empty; after close()
+// pushes fail straight away and pops drain what is left, then fail.
+template <typename T>
+class BoundedQueue
+{
+public:
+    explicit BoundedQueue(size_t maxItems) : capacity(maxItems > 0 ? maxItems : 1) {}
+
+    bool push(T item)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [this] { return closed || items.size() < capacity; });
+
+        if (closed)
+            return false;
+
+        items.push_back(std::move(item));
+        notEmpty.notify_one();
+        return true;
+    }
+
+    bool pop(T& item)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [this] { return closed || !items.empty(); });
+
+        if (items.empty())
+            return false;
+
+        item = std::move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+        }
+
+        notFull.notify_all();
+        notEmpty.notify_all();
+    }
+
+private:
+    const size_t capacity;
+    std::mutex mutex;
+    std::condition_variable notFull, notEmpty;
+    std::deque<T> items;
+    bool closed = false;
+};
@@ -0,0 +1,63 @@
+/*
+  ==============================================================================
+
+    BufferAudioFormatReader.h
+    Created: 18 Oct 2026 6:56:56am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Presents an in-memory AudioBuffer as an AudioFormatReader, so a generated
+    sound can go into a SamplerSound without being written out and re-read.
+    The buffer must outlive the reader.
+*/
+class BufferAudioFormatReader : public juce::AudioFormatReader
+{
+public:
+    BufferAudioFormatReader(const juce::AudioBuffer<float>& source, double rate)
+        : juce::AudioFormatReader(nullptr, "AudioBuffer"), buffer(source)
+    {
+        sampleRate = rate;
+        bitsPerSample = 32;
+        lengthInSamples = buffer.getNumSamples();
+        numChannels = (unsigned int)buffer.getNumChannels();
+        usesFloatingPointData = true;
+    }
+
+    bool readSamples(int* const* destChannels, int numDestChannels, int startOffsetInDestBuffer,
+                     juce::int64 startSampleInFile, int numSamples) override
+    {
+        clearSamplesBeyondAvailableLength(destChannels, numDestChannels, startOffsetInDestBuffer,
+                                          startSampleInFile, numSamples, lengthInSamples);
+
+        if (numSamples <= 0)
+            return true;
+
+        for (int channel = 0; channel < numDestChannels; ++channel)
+        {
+            auto* dest = reinterpret_cast<float*>(destChannels[channel]);
+            if (dest == nullptr)
+                continue;
+
+            dest += startOffsetInDestBuffer;
+
+            if (channel < buffer.getNumChannels())
+                juce::FloatVectorOperations::copy(dest, buffer.getReadPointer(channel, (int)startSampleInFile), numSamples);
+            else
+                juce::FloatVectorOperations::clear(dest, numSamples);
+        }
+
+        return true;
+    }
+
+private:
+    const juce::AudioBuffer<float>& buffer;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BufferAudioFormatReader)
+};
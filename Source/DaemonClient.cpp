@@ -0,0 +1,241 @@
+/*
+  ==============================================================================
+
+    DaemonClient.cpp
+    Created: 18 Oct 2026 7:16:07am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#include "DaemonClient.h"
+#include <chrono>
+
+namespace
+{
+    // The "audio" of a done message; juce::File asserts on relative paths, so those are dropped
+    juce::File getAudioFile(const juce::var& message)
+    {
+        const auto path = message["audio"].toString();
+        return juce::File::isAbsolutePath(path) ? juce::File(path) : juce::File();
+    }
+}
+
+DaemonClient::DaemonClient()
+    : juce::InterprocessConnection(false, DaemonProtocol::magicNumber)
+{
+}
+
+DaemonClient::~DaemonClient()
+{
+    disconnect();
+}
+
+bool DaemonClient::connect()
+{
+    std::lock_guard<std::mutex> cl(connectLock);
+
+    {
+        std::lock_guard<std::mutex> sl(lock);
+        if (ready && isConnected())
+            return true;
+    }
+
+    const juce::uint32 now = juce::Time::getMillisecondCounter();
+    if (lastAttempt != 0 && now - lastAttempt < (juce::uint32)retryIntervalMs)
+        return false;
+
+    lastAttempt = now;
+
+    // No daemon is the usual case, and costs one lock probe
+    const auto folder = DaemonProtocol::getConnectFolder();
+    if (!DaemonProtocol::isDaemonRunning() || !folder.isDirectory())
+        return false;
+
+    const auto id = juce::Uuid().toString();
+    if (!createPipe(DaemonProtocol::getPipeName(id), -1, true))
+        return false;
+
+    // The daemon opens the other end when the request file appears, then says it's ready
+    const auto request = folder.getChildFile(id + ".connect");
+
+    std::unique_lock<std::mutex> sl(lock);
+
+    if (request.create().wasOk())
+        replied.wait_for(sl, std::chrono::milliseconds(connectTimeoutMs), [this] { return ready; });
+
+    if (!ready)
+    {
+        sl.unlock();
+        request.deleteFile();
+        disconnect();
+        return false;
+    }
+
+    return true;
+}
+
+void DaemonClient::reset()
+{
+    {
+        std::lock_guard<std::mutex> sl(lock);
+        ready = false;
+    }
+
+    disconnect();
+}
+
+std::optional<DaemonClient::Result> DaemonClient::generate(const juce::File& imageFile, const GenerationParameters& params,
+                                                           const ProgressCallback& onProgress)
+{
+    juce::int64 id = 0;
+    {
+        std::lock_guard<std::mutex> sl(lock);
+        id = nextId++;
+        pending[id] = {};
+    }
+
+    juce::DynamicObject::Ptr request = new juce::DynamicObject();
+    request->setProperty("type", "generate");
+    request->setProperty("id", id);
+    request->setProperty("image", imageFile.getFullPathName());
+    request->setProperty("params", DaemonProtocol::toVar(params));
+
+    if (!sendMessage(DaemonProtocol::encode(juce::var(request.get()))))
+    {
+        {
+            std::lock_guard<std::mutex> sl(lock);
+            pending.erase(id);
+        }
+
+        reset();
+        return std::nullopt;
+    }
+
+    juce::var done;
+    bool stopped = false;
+    bool lost = false;
+    juce::uint32 lastCheck = juce::Time::getMillisecondCounter();
+
+    {
+        std::unique_lock<std::mutex> sl(lock);
+
+        for (;;)
+        {
+            auto& reply = pending[id];
+            if (!reply.done.isVoid())
+            {
+                done = reply.done;
+                break;
+            }
+
+            if (!ready || !isConnected())
+                break;
+
+            // A pipe doesn't say when the other process dies, but its lock does
+            const juce::uint32 now = juce::Time::getMillisecondCounter();
+            if (now - lastCheck >= (juce::uint32)livenessIntervalMs)
+            {
+                lastCheck = now;
+
+                if (!DaemonProtocol::isDaemonRunning())
+                {
+                    lost = true;
+                    break;
+                }
+            }
+
+            // Checked on every wakeup, so a cancel is noticed even while no progress arrives
+            const float progress = reply.progress;
+
+            sl.unlock();
+            const bool keepGoing = onProgress == nullptr || onProgress(progress);
+            sl.lock();
+
+            if (!keepGoing)
+            {
+                stopped = true;
+                break;
+            }
+
+            replied.wait_for(sl, std::chrono::milliseconds(50));
+        }
+
+        pending.erase(id);
+    }
+
+    if (lost)
+    {
+        reset();
+        return std::nullopt;
+    }
+
+    if (stopped)
+    {
+        juce::DynamicObject::Ptr cancel = new juce::DynamicObject();
+        cancel->setProperty("type", "cancel");
+        cancel->setProperty("id", id);
+        sendMessage(DaemonProtocol::encode(juce::var(cancel.get())));
+        return std::nullopt;
+    }
+
+    if (done["type"].toString() != "done")
+        return std::nullopt;
+
+    Result result;
+    result.sound = DaemonProtocol::mapSharedAudio(getAudioFile(done));
+    result.dominantColour = done["colour"].toString();
+    result.sampleRate = done.getProperty("sampleRate", params.sampleRate);
+
+    if (result.sound == nullptr)
+        return std::nullopt;
+
+    return result;
+}
+
+void DaemonClient::connectionLost()
+{
+    std::lock_guard<std::mutex> sl(lock);
+    ready = false;
+    replied.notify_all();
+}
+
+void DaemonClient::messageReceived(const juce::MemoryBlock& data)
+{
+    const juce::var message = DaemonProtocol::decode(data);
+    const juce::String type = message["type"].toString();
+    const auto id = (juce::int64)message["id"];
+
+    std::lock_guard<std::mutex> sl(lock);
+
+    if (type == "ready")
+    {
+        ready = true;
+        replied.notify_all();
+        return;
+    }
+
+    auto reply = pending.find(id);
+    if (reply == pending.end())
+    {
+        // A render this instance has given up on; its file would otherwise be left behind.
+        // Never anything outside the shared audio folder, whatever the message says.
+        const juce::File audioFile = getAudioFile(message);
+
+        if (type == "done" && DaemonProtocol::isSharedAudioFile(audioFile))
+            audioFile.deleteFile();
+
+        return;
+    }
+
+    if (type == "progress")
+    {
+        reply->second.progress = (float)message["progress"];
+    }
+    else if (type == "done" || type == "failed")
+    {
+        reply->second.done = message;
+    }
+
+    replied.notify_all();
+}
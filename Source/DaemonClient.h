@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+    DaemonClient.h
+    Created: 18 Oct 2026 7:16:07am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "DaemonProtocol.h"
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+//==============================================================================
+/**
+    A plugin instance's connection to the GenerationDaemon, if one is running.
+
+    Renders sent through it happen in the daemon's process, in parallel with
+    other instances' renders, and come back as a buffer mapped from shared
+    memory. When no daemon is running, connect() fails quickly and isn't
+    retried for a few seconds, so callers can simply fall back to rendering
+    locally. A daemon that goes away mid-render is noticed within a second
+    (see DaemonProtocol::isDaemonRunning).
+*/
+class DaemonClient : private juce::InterprocessConnection
+{
+public:
+    struct Result
+    {
+        std::shared_ptr<juce::AudioBuffer<float>> sound;
+        juce::String dominantColour;
+        double sampleRate = 44100.0;
+    };
+
+    // Gets progress from 0 to 1; return false to cancel
+    using ProgressCallback = std::function<bool(float progress)>;
+
+    DaemonClient();
+    ~DaemonClient() override;
+
+    // True if connected, connecting first if needed
+    bool connect();
+
+    // Blocks until the daemon replies. Empty if it failed, the connection
+    // dropped or onProgress asked to stop.
+    std::optional<Result> generate(const juce::File& imageFile, const GenerationParameters& params,
+                                   const ProgressCallback& onProgress);
+
+    static constexpr int retryIntervalMs = 5000;
+    static constexpr int connectTimeoutMs = 1000;       // for the daemon to open the pipe
+    static constexpr int livenessIntervalMs = 1000;
+
+private:
+    struct Reply
+    {
+        juce::var done;         // the "done" or "failed" message, once it arrives
+        float progress = 0.0f;
+    };
+
+    void connectionMade() override {}
+    void connectionLost() override;
+    void messageReceived(const juce::MemoryBlock& message) override;
+
+    // Drops the pipe after the daemon stopped answering
+    void reset();
+
+    std::mutex connectLock;
+    juce::uint32 lastAttempt = 0;
+
+    std::mutex lock;
+    bool ready = false;         // the daemon has opened its end of the pipe
+    std::condition_variable replied;
+    std::map<juce::int64, Reply> pending;
+    juce::int64 nextId = 1;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DaemonClient)
+};
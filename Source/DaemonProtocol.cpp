@@ -0,0 +1,253 @@
+/*
+  ==============================================================================
+
+    DaemonProtocol.cpp
+    Created: 18 Oct 2026 7:16:07am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#include "DaemonProtocol.h"
+#include "ExtendedFeatures.h"
+#include <cstring>
+#include <limits>
+
+#if JUCE_LINUX || JUCE_MAC
+ #include <sys/stat.h>
+#endif
+
+namespace
+{
+    const char audioMagic[4] = { 'I', 'M', 'S', 'A' };
+
+    struct AudioHeader
+    {
+        char magic[4];
+        uint32_t numChannels;
+        uint32_t numSamples;
+        uint32_t reserved[5];       // keeps the channel data 16 byte aligned
+    };
+
+    static_assert(sizeof(AudioHeader) == 32, "AudioHeader layout must not change");
+
+    // Owns the mapping behind a buffer returned by mapSharedAudio
+    struct MappedAudio
+    {
+        ~MappedAudio()
+        {
+            mapping.reset();
+
+            if (file != juce::File())
+                file.deleteFile();
+        }
+
+        juce::File file;        // set once the file has been validated
+        std::unique_ptr<juce::MemoryMappedFile> mapping;
+        juce::AudioBuffer<float> buffer;
+    };
+}
+
+namespace DaemonProtocol
+{
+    juce::MemoryBlock encode(const juce::var& message)
+    {
+        const auto text = juce::JSON::toString(message, true);
+        return juce::MemoryBlock(text.toRawUTF8(), text.getNumBytesAsUTF8());
+    }
+
+    juce::var decode(const juce::MemoryBlock& message)
+    {
+        return juce::JSON::parse(message.toString());
+    }
+
+    juce::var toVar(const GenerationParameters& params)
+    {
+        auto* object = new juce::DynamicObject();
+        object->setProperty("kernelSize", params.kernelSize);
+        object->setProperty("stepSize", params.stepSize);
+        object->setProperty("soundLevel", params.soundLevel);
+        object->setProperty("soundDuration", params.soundDuration);
+        object->setProperty("modulationIntensity", params.modulationIntensity);
+        object->setProperty("modulationEnvelopeIntensity", params.modulationEnvelopeIntensity);
+        object->setProperty("modulationDuration", params.modulationDuration);
+        object->setProperty("lfoScalarFreq", params.lfoScalarFreq);
+        object->setProperty("lfoScalarAmplitude", params.lfoScalarAmplitude);
+        object->setProperty("lfoIntensity", params.lfoIntensity);
+        object->setProperty("overtoneNumScalar", params.overtoneNumScalar);
+        object->setProperty("lfoAmountScalar", params.lfoAmountScalar);
+        object->setProperty("traversal", WindowTraversal::getName(params.traversal));
+        object->setProperty("fmDepthSource", ExtendedFeatureExtractor::getName(params.fmDepthSource));
+        object->setProperty("overtoneSource", ExtendedFeatureExtractor::getName(params.overtoneSource));
+        object->setProperty("lfoRateSource", ExtendedFeatureExtractor::getName(params.lfoRateSource));
+        object->setProperty("sampleRate", params.sampleRate);
+
+        return juce::var(object);
+    }
+
+    GenerationParameters parametersFromVar(const juce::var& value)
+    {
+        GenerationParameters params;
+        params.kernelSize = value.getProperty("kernelSize", params.kernelSize);
+        params.stepSize = value.getProperty("stepSize", params.stepSize);
+        params.soundLevel = value.getProperty("soundLevel", params.soundLevel);
+        params.soundDuration = value.getProperty("soundDuration", params.soundDuration);
+        params.modulationIntensity = value.getProperty("modulationIntensity", params.modulationIntensity);
+        params.modulationEnvelopeIntensity = value.getProperty("modulationEnvelopeIntensity", params.modulationEnvelopeIntensity);
+        params.modulationDuration = value.getProperty("modulationDuration", params.modulationDuration);
+        params.lfoScalarFreq = value.getProperty("lfoScalarFreq", params.lfoScalarFreq);
+        params.lfoScalarAmplitude = value.getProperty("lfoScalarAmplitude", params.lfoScalarAmplitude);
+        params.lfoIntensity = value.getProperty("lfoIntensity", params.lfoIntensity);
+        params.overtoneNumScalar = value.getProperty("overtoneNumScalar", params.overtoneNumScalar);
+        params.lfoAmountScalar = value.getProperty("lfoAmountScalar", params.lfoAmountScalar);
+        WindowTraversal::fromName(value.getProperty("traversal", {}).toString(), params.traversal);
+        ExtendedFeatureExtractor::fromName(value.getProperty("fmDepthSource", {}).toString(), params.fmDepthSource);
+        ExtendedFeatureExtractor::fromName(value.getProperty("overtoneSource", {}).toString(), params.overtoneSource);
+        ExtendedFeatureExtractor::fromName(value.getProperty("lfoRateSource", {}).toString(), params.lfoRateSource);
+        params.sampleRate = value.getProperty("sampleRate", params.sampleRate);
+
+        return params;
+    }
+
+    juce::File getRuntimeFolder()
+    {
+       #if JUCE_LINUX
+        // tmpfs, and already private to the user
+        const juce::File runtime(juce::SystemStats::getEnvironmentVariable("XDG_RUNTIME_DIR", {}));
+        if (runtime.isDirectory())
+            return runtime.getChildFile("imagine");
+       #endif
+
+        return juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("Imagine Daemon");
+    }
+
+    juce::File getConnectFolder()
+    {
+        return getRuntimeFolder().getChildFile("connect");
+    }
+
+    juce::File getSharedAudioFolder()
+    {
+        return getRuntimeFolder().getChildFile("audio");
+    }
+
+    bool createPrivateFolder(const juce::File& folder)
+    {
+        for (const auto& f : { getRuntimeFolder(), folder })
+        {
+            if (f.createDirectory().failed())
+                return false;
+
+           #if JUCE_LINUX || JUCE_MAC
+            if (::chmod(f.getFullPathName().toRawUTF8(), S_IRWXU) != 0)
+                return false;
+           #endif
+        }
+
+        return true;
+    }
+
+    juce::String getPipeName(const juce::String& connectionId)
+    {
+       #if JUCE_WINDOWS
+        return "imagine-" + connectionId;
+       #else
+        return getRuntimeFolder().getChildFile(connectionId + ".pipe").getFullPathName();
+       #endif
+    }
+
+    bool isDaemonRunning()
+    {
+        juce::InterProcessLock probe(daemonLockName);
+
+        if (!probe.enter(0))
+            return true;
+
+        probe.exit();
+        return false;
+    }
+
+    bool isSharedAudioFile(const juce::File& file)
+    {
+        // juce::File resolves ".." when it's constructed, so the parent really is the folder
+        return file.getParentDirectory() == getSharedAudioFolder()
+            && file.hasFileExtension("audio")
+            && !file.isSymbolicLink()
+            && file.existsAsFile();
+    }
+
+    bool writeSharedAudio(const juce::AudioBuffer<float>& sound, const juce::File& file)
+    {
+        if (!createPrivateFolder(file.getParentDirectory()))
+            return false;
+
+        AudioHeader header{};
+        std::memcpy(header.magic, audioMagic, sizeof(audioMagic));
+        header.numChannels = (uint32_t)sound.getNumChannels();
+        header.numSamples = (uint32_t)sound.getNumSamples();
+
+        // The instance may map the file as soon as it's told the name, so it has to be complete by then
+        juce::TemporaryFile temp(file);
+
+        {
+            std::unique_ptr<juce::FileOutputStream> out(temp.getFile().createOutputStream());
+            if (out == nullptr || out->failedToOpen())
+                return false;
+
+            out->write(&header, sizeof(AudioHeader));
+
+            for (int channel = 0; channel < sound.getNumChannels(); ++channel)
+                out->write(sound.getReadPointer(channel), (size_t)sound.getNumSamples() * sizeof(float));
+
+            out->flush();
+
+            if (out->getStatus().failed())
+                return false;
+        }
+
+        return temp.overwriteTargetFileWithTemporary();
+    }
+
+    std::shared_ptr<juce::AudioBuffer<float>> mapSharedAudio(const juce::File& file)
+    {
+        if (!isSharedAudioFile(file))
+            return {};
+
+        // Nothing downstream writes to a generated sound, so the mapping can be read only
+        auto owner = std::make_shared<MappedAudio>();
+        owner->mapping = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+
+        auto* data = static_cast<char*>(owner->mapping->getData());
+        const size_t size = owner->mapping->getSize();
+
+        AudioHeader header{};
+        if (data != nullptr && size >= sizeof(AudioHeader))
+            std::memcpy(&header, data, sizeof(AudioHeader));
+
+        const size_t expectedSize = sizeof(AudioHeader) + (size_t)header.numChannels * header.numSamples * sizeof(float);
+
+        if (data == nullptr
+            || std::memcmp(header.magic, audioMagic, sizeof(audioMagic)) != 0
+            || header.numChannels == 0
+            || header.numSamples == 0
+            || header.numSamples > (uint32_t)std::numeric_limits<int>::max()
+            || size != expectedSize)
+        {
+            return {};
+        }
+
+        float* channels[8] = {};
+        const int numChannels = juce::jmin((int)header.numChannels, (int)juce::numElementsInArray(channels));
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            channels[channel] = reinterpret_cast<float*>(data + sizeof(AudioHeader)) + (size_t)channel * header.numSamples;
+
+        owner->buffer.setDataToReferTo(channels, numChannels, (int)header.numSamples);
+
+        // Only now is the file known to be ours to delete
+        owner->file = file;
+
+        // Shares ownership with the mapping, but points at the buffer
+        return std::shared_ptr<juce::AudioBuffer<float>>(owner, &owner->buffer);
+    }
+}
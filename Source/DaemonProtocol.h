@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    DaemonProtocol.h
+    Created: 18 Oct 2026 7:16:07am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "ImageSynthEngine.h"
+#include <memory>
+
+//==============================================================================
+/**
+    What the generation daemon and the plugin instances say to each other.
+
+    Messages are JSON objects sent over an InterprocessConnection on a named
+    pipe, one pipe per instance:
+
+        instance -> daemon   { "type": "generate", "id", "image", "params" }
+                             { "type": "cancel", "id" }
+        daemon -> instance   { "type": "ready" }
+                             { "type": "progress", "id", "progress" }
+                             { "type": "done", "id", "audio", "colour", "sampleRate" }
+                             { "type": "failed", "id" }
+
+    An instance creates its pipe, then asks for it to be opened by creating
+    an empty {id}.connect file in getConnectFolder(); the daemon opens the
+    other end and says "ready". Both folders live in getRuntimeFolder(),
+    which only the user can enter, so neither another user nor anything
+    listening on a port can talk to an instance. On Windows the pipe's
+    default DACL only lets its owner open it for writing.
+
+    Rendered audio doesn't go through the pipe: the daemon writes it to a
+    file in getSharedAudioFolder() (tmpfs on Linux) and the instance maps it
+    and plays straight from the mapping.
+*/
+namespace DaemonProtocol
+{
+    // Sent as each connection's magic number, so a mismatched daemon is never used.
+    // Bumped whenever a message or a parameter in it changes.
+    constexpr juce::uint32 magicNumber = 0x494d4732;    // "IMG2"
+
+    // Held by the daemon for as long as it runs (see isDaemonRunning)
+    constexpr const char* daemonLockName = "ImagineGenerationDaemon";
+
+    juce::MemoryBlock encode(const juce::var& message);
+    juce::var decode(const juce::MemoryBlock& message);
+
+    juce::var toVar(const GenerationParameters& params);
+    GenerationParameters parametersFromVar(const juce::var& value);
+
+    // $XDG_RUNTIME_DIR/imagine where there is one, otherwise a folder in the
+    // user's temp directory. Made readable by the user only.
+    juce::File getRuntimeFolder();
+    juce::File getConnectFolder();
+    juce::File getSharedAudioFolder();
+
+    // Creates the folder (and the runtime folder) with user-only permissions
+    bool createPrivateFolder(const juce::File& folder);
+
+    // The pipe an instance creates for the given connection id; a plain name on
+    // Windows, a path in getRuntimeFolder() elsewhere
+    juce::String getPipeName(const juce::String& connectionId);
+
+    // True if another process holds daemonLockName
+    bool isDaemonRunning();
+
+    // Only *.audio files directly inside getSharedAudioFolder() are ever mapped or deleted
+    bool isSharedAudioFile(const juce::File& file);
+
+    // Writes planar float samples with a small header; the file appears in one rename
+    bool writeSharedAudio(const juce::AudioBuffer<float>& sound, const juce::File& file);
+
+    // Maps a file written by writeSharedAudio, read only. The buffer refers to the
+    // mapping rather than copying it, and the file is deleted when the buffer goes.
+    // Null, with the file left alone, if it isn't a valid shared audio file.
+    std::shared_ptr<juce::AudioBuffer<float>> mapSharedAudio(const juce::File& file);
+}
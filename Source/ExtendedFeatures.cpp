@@ -0,0 +1,304 @@
+/*
+  ==============================================================================
+
+    ExtendedFeatures.cpp
+    Created: 18 Oct 2026 7:39:44am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#include "ExtendedFeatures.h"
+#include "ImageLoader.h"
+#include "ParallelFor.h"
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    // Window sums kept per column, in this order
+    enum Quantity { redSum, greenSum, blueSum, saturationSum, valueSum, lumaSum, lumaSquaredSum, edgeSum, numQuantities };
+
+    // Rec. 601 luma of one row, in [0, 1]
+    void computeLuma(const PlanarImage& image, int y, float norm, float* luma)
+    {
+        const size_t offset = (size_t)y * (size_t)image.width;
+        const uint16_t* red = image.planes[0].data() + offset;
+        const uint16_t* green = image.planes[1].data() + offset;
+        const uint16_t* blue = image.planes[2].data() + offset;
+
+        for (int x = 0; x < image.width; ++x)
+            luma[x] = (0.299f * (float)red[x] + 0.587f * (float)green[x] + 0.114f * (float)blue[x]) * norm;
+    }
+
+    // Per-row working buffers, one set per worker
+    struct RowScratch
+    {
+        explicit RowScratch(int width)
+            : colour(3, std::vector<float>((size_t)width)), quantity(4, std::vector<float>((size_t)width)),
+              maxColour((size_t)width), minColour((size_t)width), columnSum((size_t)width), columnDifference((size_t)width),
+              gradientX((size_t)width), gradientY((size_t)width), prefix(((size_t)width + 1) * (size_t)numQuantities, 0.0)
+        {
+        }
+
+        std::vector<std::vector<float>> colour;     // raw samples, so the colour sums stay integral
+        std::vector<std::vector<float>> quantity;   // saturation, value, luma squared, edge
+        std::vector<float> maxColour, minColour;
+        std::vector<float> columnSum, columnDifference, gradientX, gradientY;
+        std::vector<double> prefix;                 // [x][quantity], interleaved
+    };
+
+    // Every quantity for scanline y, reduced to one sum per window column
+    void computeRowSums(const PlanarImage& image, int y, const float* lumaAbove, const float* luma, const float* lumaBelow,
+                        float norm, int kernel, int step, int numCols, RowScratch& scratch, double* sums)
+    {
+        using FVO = juce::FloatVectorOperations;
+
+        const int width = image.width;
+        const size_t offset = (size_t)y * (size_t)width;
+
+        for (int c = 0; c < 3; ++c)
+        {
+            const uint16_t* plane = image.planes[(size_t)c].data() + offset;
+            float* colour = scratch.colour[(size_t)c].data();
+
+            for (int x = 0; x < width; ++x)
+                colour[x] = (float)plane[x];
+        }
+
+        const float* red = scratch.colour[0].data();
+        const float* green = scratch.colour[1].data();
+        const float* blue = scratch.colour[2].data();
+        float* maxColour = scratch.maxColour.data();
+        float* minColour = scratch.minColour.data();
+
+        FVO::max(maxColour, red, green, width);
+        FVO::max(maxColour, maxColour, blue, width);
+        FVO::min(minColour, red, green, width);
+        FVO::min(minColour, minColour, blue, width);
+
+        float* saturation = scratch.quantity[0].data();
+        float* value = scratch.quantity[1].data();
+        float* lumaSquared = scratch.quantity[2].data();
+        float* edge = scratch.quantity[3].data();
+
+        // HSV saturation is (max - min) / max, and 0 for black; the scale cancels out
+        FVO::subtract(saturation, maxColour, minColour, width);
+        for (int x = 0; x < width; ++x)
+            saturation[x] = maxColour[x] > 0.0f ? saturation[x] / maxColour[x] : 0.0f;
+
+        FVO::multiply(value, maxColour, norm, width);
+        FVO::multiply(lumaSquared, luma, luma, width);
+
+        // 3x3 Sobel on luma, edges clamped. It is separable: a [1 2 1] sum down each
+        // column differenced across, and a difference down each column summed across.
+        float* columnSum = scratch.columnSum.data();
+        float* columnDifference = scratch.columnDifference.data();
+        float* gx = scratch.gradientX.data();
+        float* gy = scratch.gradientY.data();
+
+        FVO::add(columnSum, lumaAbove, lumaBelow, width);
+        FVO::addWithMultiply(columnSum, luma, 2.0f, width);
+        FVO::subtract(columnDifference, lumaBelow, lumaAbove, width);
+
+        auto clampedGradients = [&](int x)
+        {
+            const int left = juce::jmax(0, x - 1);
+            const int right = juce::jmin(width - 1, x + 1);
+            gx[x] = columnSum[right] - columnSum[left];
+            gy[x] = columnDifference[left] + 2.0f * columnDifference[x] + columnDifference[right];
+        };
+
+        if (width > 2)
+        {
+            FVO::subtract(gx + 1, columnSum + 2, columnSum, width - 2);
+            FVO::add(gy + 1, columnDifference, columnDifference + 2, width - 2);
+            FVO::addWithMultiply(gy + 1, columnDifference + 1, 2.0f, width - 2);
+            clampedGradients(0);
+            clampedGradients(width - 1);
+        }
+        else
+        {
+            for (int x = 0; x < width; ++x)
+                clampedGradients(x);
+        }
+
+        const float threshold = ExtendedFeatureExtractor::edgeThreshold * ExtendedFeatureExtractor::edgeThreshold;
+
+        FVO::multiply(gx, gx, width);
+        FVO::addWithMultiply(gx, gy, gy, width);
+        for (int x = 0; x < width; ++x)
+            edge[x] = gx[x] > threshold ? 1.0f : 0.0f;
+
+        // One prefix pass for all quantities, then every window's sums from two rows of it
+        const float* values[numQuantities] = { red, green, blue, saturation, value, luma, lumaSquared, edge };
+        double* prefix = scratch.prefix.data();
+
+        for (int x = 0; x < width; ++x)
+        {
+            const double* previous = prefix + (size_t)x * numQuantities;
+            double* next = prefix + (size_t)(x + 1) * numQuantities;
+
+            for (int q = 0; q < numQuantities; ++q)
+                next[q] = previous[q] + (double)values[q][x];
+        }
+
+        for (int col = 0; col < numCols; ++col)
+        {
+            const double* left = prefix + (size_t)col * (size_t)step * numQuantities;
+            const double* right = left + (size_t)kernel * numQuantities;
+
+            for (int q = 0; q < numQuantities; ++q)
+                sums[(size_t)q * (size_t)numCols + (size_t)col] = right[q] - left[q];
+        }
+    }
+
+    const char* const sourceNames[] = { "none", "saturation", "value", "variance", "edges" };
+}
+
+ImageFeatures ExtendedFeatureExtractor::compute(const PlanarImage& image, int kernelSize, int stepSize, TraversalOrder order)
+{
+    if (image.isEmpty())
+        throw std::invalid_argument("Image cannot be null");
+
+    if (kernelSize <= 0 || stepSize <= 0)
+        throw std::invalid_argument("Kernel size and step size must be positive");
+
+    if (kernelSize > image.getSourceHeight() || kernelSize > image.getSourceWidth())
+        throw std::invalid_argument("Kernel size cannot be larger than the image");
+
+    const int scale = juce::jmax(1, image.scale);
+    if (kernelSize % scale != 0 || stepSize % scale != 0)
+        throw std::invalid_argument("Kernel size and step size must be multiples of the image scale");
+
+    // In image samples, as in IntegralImage
+    const int width = image.width;
+    const int height = image.height;
+    const int kernel = kernelSize / scale;
+    const int step = stepSize / scale;
+
+    const int numRows = (height - kernel) / step + 1;
+    const int numCols = (width - kernel) / step + 1;
+    const size_t numWindows = (size_t)numRows * (size_t)numCols;
+
+    ImageFeatures features;
+    features.red.resize(numWindows);
+    features.green.resize(numWindows);
+    features.blue.resize(numWindows);
+    for (auto& channel : features.extended)
+        channel.resize(numWindows);
+
+    const auto ranks = WindowTraversal::computeRanks(order, numRows, numCols);
+    const double colourArea = (double)kernelSize * (double)kernelSize;      // source pixels
+    const double sampleArea = (double)kernel * (double)kernel;
+    const float norm = 1.0f / (255.0f * (float)(scale * scale));
+
+    const int usedRows = (numRows - 1) * step + kernel;
+    const int stripCapacity = juce::jmin(rowsPerStrip, usedRows);
+    const size_t sumsPerRow = (size_t)numQuantities * (size_t)numCols;     // [quantity][column]
+
+    // The strip's luma plus a row either side for the Sobel kernel
+    std::vector<float> luma((size_t)(stripCapacity + 2) * (size_t)width);
+    std::vector<double> rowSums((size_t)stripCapacity * sumsPerRow);
+
+    const int ringSize = (kernel + step - 1) / step + 1;
+    std::vector<double> openRows((size_t)ringSize * sumsPerRow, 0.0);
+
+    for (int stripStart = 0; stripStart < usedRows; stripStart += stripCapacity)
+    {
+        const int stripRows = juce::jmin(stripCapacity, usedRows - stripStart);
+
+        parallelFor(0, stripRows + 2, 16, [&](int begin, int end)
+            {
+                for (int i = begin; i < end; ++i)
+                    computeLuma(image, juce::jlimit(0, height - 1, stripStart - 1 + i), norm, luma.data() + (size_t)i * (size_t)width);
+            });
+
+        parallelFor(0, stripRows, 8, [&](int begin, int end)
+            {
+                RowScratch scratch(width);
+
+                for (int r = begin; r < end; ++r)
+                {
+                    const float* lumaRow = luma.data() + (size_t)(r + 1) * (size_t)width;
+
+                    computeRowSums(image, stripStart + r, lumaRow - width, lumaRow, lumaRow + width,
+                                   norm, kernel, step, numCols, scratch, rowSums.data() + (size_t)r * sumsPerRow);
+                }
+            });
+
+        // Into the window rows each scanline belongs to; columns split across cores
+        parallelFor(0, numCols, 256, [&](int colBegin, int colEnd)
+            {
+                for (int r = 0; r < stripRows; ++r)
+                {
+                    const int y = stripStart + r;
+                    const int firstWindowRow = y < kernel ? 0 : (y - kernel) / step + 1;
+                    const int lastWindowRow = juce::jmin(y / step, numRows - 1);
+                    const double* sums = rowSums.data() + (size_t)r * sumsPerRow;
+
+                    for (int w = firstWindowRow; w <= lastWindowRow; ++w)
+                    {
+                        double* open = openRows.data() + (size_t)(w % ringSize) * sumsPerRow;
+
+                        for (int q = 0; q < numQuantities; ++q)
+                        {
+                            const size_t offset = (size_t)q * (size_t)numCols;
+                            for (int col = colBegin; col < colEnd; ++col)
+                                open[offset + (size_t)col] += sums[offset + (size_t)col];
+                        }
+
+                        if (y != w * step + kernel - 1)
+                            continue;
+
+                        for (int col = colBegin; col < colEnd; ++col)
+                        {
+                            auto take = [&](int q)
+                            {
+                                double& sum = open[(size_t)q * (size_t)numCols + (size_t)col];
+                                const double value = sum;
+                                sum = 0.0;
+                                return value;
+                            };
+
+                            const auto rank = (size_t)WindowTraversal::getRank(ranks, w, col, numCols);
+
+                            // Matches (np.mean(window) + 1e-12) / 256 in image_convolution
+                            features.red[rank] = (float)((take(redSum) / colourArea + 0.000000000001) / 256.0);
+                            features.green[rank] = (float)((take(greenSum) / colourArea + 0.000000000001) / 256.0);
+                            features.blue[rank] = (float)((take(blueSum) / colourArea + 0.000000000001) / 256.0);
+
+                            const double meanLuma = take(lumaSum) / sampleArea;
+                            const double variance = take(lumaSquaredSum) / sampleArea - meanLuma * meanLuma;
+
+                            features.extended[(size_t)ExtendedFeature::saturation][rank] = (float)(take(saturationSum) / sampleArea);
+                            features.extended[(size_t)ExtendedFeature::value][rank] = (float)(take(valueSum) / sampleArea);
+                            features.extended[(size_t)ExtendedFeature::luminanceVariance][rank] = (float)juce::jlimit(0.0, 1.0, 4.0 * variance);
+                            features.extended[(size_t)ExtendedFeature::edgeDensity][rank] = (float)(take(edgeSum) / sampleArea);
+                        }
+                    }
+                }
+            });
+    }
+
+    return features;
+}
+
+juce::String ExtendedFeatureExtractor::getName(FeatureSource source)
+{
+    return sourceNames[juce::jlimit(0, 4, (int)source)];
+}
+
+bool ExtendedFeatureExtractor::fromName(const juce::String& name, FeatureSource& source)
+{
+    for (int i = 0; i < 5; ++i)
+    {
+        if (name.trim().equalsIgnoreCase(sourceNames[i]))
+        {
+            source = (FeatureSource)i;
+            return true;
+        }
+    }
+
+    return false;
+}
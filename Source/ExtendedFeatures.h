@@ -0,0 +1,50 @@
+/*
+  ==============================================================================
+
+    ExtendedFeatures.h
+    Created: 18 Oct 2026 7:39:44am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "ImageFeatures.h"
+#include "ImageSynthEngine.h"
+
+//==============================================================================
+/**
+    Colour means plus the extended features (saturation, value, luminance
+    variance and edge density) for every window, in one sweep over the image.
+
+    Before, brightness() and color_avg() were worked out from the RGB means
+    after the fact, one pass each. Here each scanline becomes per-sample rows
+    of every quantity at once: colour, HSV saturation and value, luma, luma
+    squared and a separable Sobel edge flag, computed with
+    FloatVectorOperations. One prefix pass over all of them gives every
+    window sum for the row, and those are added into the window rows still
+    open, the same way TiledImageReader does it. Variance comes from the luma
+    and luma-squared sums, so no window is visited twice.
+
+    Works on a PlanarImage, from the loader or recovered from a pyramid level
+    (IntegralImage::toPlanarImage). When that is downscaled (scale > 1), the
+    extended features see block-averaged pixels, while the colour means stay
+    exact.
+*/
+class ExtendedFeatureExtractor
+{
+public:
+    // Sobel gradient magnitude, on luma in [0, 1], above which a pixel counts as an edge
+    static constexpr float edgeThreshold = 0.5f;
+    static constexpr int rowsPerStrip = 64;
+
+    // Same means, order and std::invalid_argument messages as IntegralImage::computeBlockMeans,
+    // with ImageFeatures::extended filled in
+    static ImageFeatures compute(const PlanarImage& image, int kernelSize, int stepSize,
+                                 TraversalOrder order = TraversalOrder::raster);
+
+    // "none", "saturation", "value", "variance" or "edges"
+    static juce::String getName(FeatureSource source);
+    static bool fromName(const juce::String& name, FeatureSource& source);
+};
@@ -0,0 +1,189 @@
+/*
+  ==============================================================================
+
+    FeatureCache.cpp
+    Created: 18 Oct 2026 7:05:03am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#include "FeatureCache.h"
+#include <algorithm>
+#include <cstring>
+
+static const char cacheMagic[4] = { 'I', 'M', 'F', 'C' };
+
+FeatureCache::FeatureCache(const juce::File& dir, juce::int64 maxSizeBytes)
+    : directory(dir), maxSize(maxSizeBytes)
+{
+}
+
+juce::File FeatureCache::getDefaultDirectory()
+{
+    return juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+        .getChildFile("Imagine")
+        .getChildFile("Cache");
+}
+
+juce::String FeatureCache::hashImage(const juce::File& imageFile)
+{
+    if (!imageFile.existsAsFile())
+        return {};
+
+    return juce::MD5(imageFile).toHexString();
+}
+
+juce::String FeatureCache::hashImage(const juce::MemoryBlock& fileData)
+{
+    if (fileData.isEmpty())
+        return {};
+
+    return juce::MD5(fileData).toHexString();
+}
+
+juce::File FeatureCache::getEntryFile(const juce::String& imageHash, int kernelSize, int stepSize, TraversalOrder order) const
+{
+    // Raster entries keep their original names
+    const juce::String suffix = order == TraversalOrder::raster ? juce::String() : "_" + WindowTraversal::getName(order);
+
+    return directory.getChildFile(imageHash + "_" + juce::String(kernelSize) + "_" + juce::String(stepSize) + suffix + ".features");
+}
+
+std::unique_ptr<FeatureCache::Entry> FeatureCache::find(const juce::String& imageHash, int kernelSize, int stepSize, TraversalOrder order,
+                                                        bool extended)
+{
+    if (imageHash.isEmpty())
+        return {};
+
+    // Held until the entry is validated; the mapping stays usable after another instance replaces the file
+    const juce::ScopedLock sl(processLock->lock);
+
+    const juce::File file = getEntryFile(imageHash, kernelSize, stepSize, order);
+    if (!file.existsAsFile())
+        return {};
+
+    // Touch before mapping: eviction goes by modification time
+    file.setLastModificationTime(juce::Time::getCurrentTime());
+
+    auto entry = std::make_unique<Entry>();
+    entry->mappedFile = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+
+    const auto* data = static_cast<const char*>(entry->mappedFile->getData());
+    const size_t size = entry->mappedFile->getSize();
+
+    FileHeader header{};
+    if (data != nullptr && size >= sizeof(FileHeader))
+        std::memcpy(&header, data, sizeof(FileHeader));
+
+    const size_t expectedSize = sizeof(FileHeader) + (size_t)header.numChannels * (size_t)header.numWindows * sizeof(float);
+
+    if (data == nullptr
+        || std::memcmp(header.magic, cacheMagic, sizeof(cacheMagic)) != 0
+        || header.version != formatVersion
+        || header.kernelSize != (uint32_t)kernelSize
+        || header.stepSize != (uint32_t)stepSize
+        || header.traversal != (uint32_t)order
+        || (header.numChannels != colourChannels && header.numChannels != allChannels)
+        || header.numWindows == 0
+        || size != expectedSize)
+    {
+        entry.reset();
+        file.deleteFile();
+        return {};
+    }
+
+    // A sound entry, just not one with everything asked for
+    if (extended && header.numChannels != allChannels)
+        return {};
+
+    const auto* red = reinterpret_cast<const float*>(data + sizeof(FileHeader));
+    const auto numWindows = (int)header.numWindows;
+    entry->channels = { { red, red + numWindows, red + 2 * numWindows }, numWindows };
+
+    if (header.numChannels == allChannels)
+        for (size_t f = 0; f < entry->channels.extended.size(); ++f)
+            entry->channels.extended[f] = red + (3 + f) * (size_t)numWindows;
+
+    return entry;
+}
+
+bool FeatureCache::store(const juce::String& imageHash, int kernelSize, int stepSize, const ImageFeatures& features,
+                         TraversalOrder order)
+{
+    if (imageHash.isEmpty() || features.isEmpty())
+        return false;
+
+    const juce::ScopedLock sl(processLock->lock);
+
+    if (directory.createDirectory().failed())
+        return false;
+
+    FileHeader header{};
+    std::memcpy(header.magic, cacheMagic, sizeof(cacheMagic));
+    header.version = formatVersion;
+    header.numWindows = (uint32_t)features.size();
+    header.kernelSize = (uint32_t)kernelSize;
+    header.stepSize = (uint32_t)stepSize;
+    header.traversal = (uint32_t)order;
+    header.numChannels = features.hasExtended() ? allChannels : colourChannels;
+
+    // Written next to the target and moved into place, so a reader never maps half an entry
+    const juce::File file = getEntryFile(imageHash, kernelSize, stepSize, order);
+    juce::TemporaryFile temp(file);
+
+    {
+        std::unique_ptr<juce::FileOutputStream> out(temp.getFile().createOutputStream());
+        if (out == nullptr || out->failedToOpen())
+            return false;
+
+        const size_t channelBytes = features.red.size() * sizeof(float);
+        out->write(&header, sizeof(FileHeader));
+        out->write(features.red.data(), channelBytes);
+        out->write(features.green.data(), channelBytes);
+        out->write(features.blue.data(), channelBytes);
+
+        if (features.hasExtended())
+            for (const auto& channel : features.extended)
+                out->write(channel.data(), channelBytes);
+
+        out->flush();
+
+        if (out->getStatus().failed())
+            return false;
+    }
+
+    if (!temp.overwriteTargetFileWithTemporary())
+        return false;
+
+    evict();
+    return true;
+}
+
+void FeatureCache::evict()
+{
+    auto entries = directory.findChildFiles(juce::File::findFiles, false, "*.features");
+
+    juce::int64 totalSize = 0;
+    for (const auto& entry : entries)
+        totalSize += entry.getSize();
+
+    if (totalSize <= maxSize)
+        return;
+
+    std::sort(entries.begin(), entries.end(), [](const juce::File& a, const juce::File& b)
+        {
+            return a.getLastModificationTime() < b.getLastModificationTime();
+        });
+
+    // An entry that's mapped by another instance may refuse to go; skip it
+    for (const auto& entry : entries)
+    {
+        if (totalSize <= maxSize)
+            break;
+
+        const juce::int64 size = entry.getSize();
+        if (entry.deleteFile())
+            totalSize -= size;
+    }
+}
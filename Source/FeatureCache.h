@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+    FeatureCache.h
+    Created: 18 Oct 2026 7:05:03am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "ImageFeatures.h"
+#include <cstdint>
+#include <memory>
+
+//==============================================================================
+/**
+    On-disk cache of extracted block means, under Documents/Imagine/Cache.
+
+    Entries are keyed by the MD5 of the image file's content plus kernel and
+    step size and the window order, so renamed or copied images still hit. Each entry is a small
+    header followed by the red, green and blue float arrays, then the four
+    extended feature arrays if they were extracted, and is memory
+    mapped on lookup: the generator reads the features straight from the
+    mapping, with no decode, convolution or copy.
+
+    The directory is kept under a size cap by deleting the least recently
+    used entries after each store. A hit counts as a use. Lookups, stores and
+    eviction are serialised by one lock shared by every FeatureCache in the
+    process, so one instance never evicts or replaces an entry while another
+    is validating it.
+*/
+class FeatureCache
+{
+public:
+    // A mapped cache file; the channels stay valid for the entry's lifetime
+    class Entry
+    {
+    public:
+        const FeatureChannels& getChannels() const { return channels; }
+
+    private:
+        friend class FeatureCache;
+
+        std::unique_ptr<juce::MemoryMappedFile> mappedFile;
+        FeatureChannels channels;
+    };
+
+    explicit FeatureCache(const juce::File& directory = getDefaultDirectory(), juce::int64 maxSizeBytes = defaultMaxSize);
+
+    static juce::File getDefaultDirectory();
+
+    // MD5 of the file's bytes as hex, or empty if it can't be read
+    static juce::String hashImage(const juce::File& imageFile);
+
+    // The same hash from the file's bytes
+    static juce::String hashImage(const juce::MemoryBlock& fileData);
+
+    // Null on a miss, or if the entry is unreadable (it is then deleted). With
+    // extended, an entry that only holds colour means is a miss too.
+    std::unique_ptr<Entry> find(const juce::String& imageHash, int kernelSize, int stepSize,
+                                TraversalOrder order = TraversalOrder::raster, bool extended = false);
+
+    // Writes the entry atomically, extended channels included if features has them,
+    // then evicts down to the size cap
+    bool store(const juce::String& imageHash, int kernelSize, int stepSize, const ImageFeatures& features,
+               TraversalOrder order = TraversalOrder::raster);
+
+    static constexpr juce::int64 defaultMaxSize = 256 * 1024 * 1024;
+
+private:
+    struct FileHeader
+    {
+        char magic[4];
+        uint32_t version;
+        uint32_t numWindows;
+        uint32_t kernelSize;
+        uint32_t stepSize;
+        uint32_t traversal;         // TraversalOrder; 0 (raster) in entries from before it existed
+        uint32_t numChannels;       // 3 colour means, or 7 with the extended features
+        uint32_t reserved;          // keeps the float arrays 16 byte aligned
+    };
+
+    static_assert(sizeof(FileHeader) == 32, "FileHeader layout must not change");
+
+    // 2: images between 3840x2160 and TiledImageReader::maxDecodedPixels are squashed again
+    // 3: numChannels, and the extended features after the colour means
+    // 4: no image is squashed to 3840x2160 any more
+    static constexpr uint32_t formatVersion = 4;
+    static constexpr uint32_t colourChannels = 3;
+    static constexpr uint32_t allChannels = 7;
+
+    juce::File getEntryFile(const juce::String& imageHash, int kernelSize, int stepSize, TraversalOrder order) const;
+    void evict();
+
+    // Shared between instances through a juce::SharedResourcePointer
+    struct ProcessLock
+    {
+        juce::CriticalSection lock;
+    };
+
+    juce::File directory;
+    juce::int64 maxSize;
+    juce::SharedResourcePointer<ProcessLock> processLock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FeatureCache)
+};
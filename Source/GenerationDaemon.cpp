@@ -0,0 +1,312 @@
+/*
+  ==============================================================================
+
+    GenerationDaemon.cpp
+    Created: 18 Oct 2026 7:16:07am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#include "GenerationDaemon.h"
+#include <algorithm>
+#include <atomic>
+#include <set>
+
+namespace
+{
+    juce::DynamicObject::Ptr makeMessage(const char* type, juce::int64 id)
+    {
+        juce::DynamicObject::Ptr message = new juce::DynamicObject();
+        message->setProperty("type", type);
+        message->setProperty("id", id);
+        return message;
+    }
+}
+
+//==============================================================================
+// One connected plugin instance. Callbacks arrive on the connection's own
+// thread; renders run on the daemon's pool and hold a reference to the
+// connection, so it outlives a client that goes away mid-render.
+class GenerationDaemon::Connection : public juce::InterprocessConnection,
+                                     public std::enable_shared_from_this<Connection>
+{
+public:
+    explicit Connection(GenerationDaemon& d)
+        : juce::InterprocessConnection(false, DaemonProtocol::magicNumber), daemon(d)
+    {
+    }
+
+    ~Connection() override
+    {
+        disconnect();
+    }
+
+    bool isClosed() const { return closed; }
+
+    void close()
+    {
+        closed = true;
+        disconnect();
+    }
+
+    void connectionMade() override {}
+
+    void connectionLost() override
+    {
+        // Renders still running for this instance stop at their next progress check
+        closed = true;
+    }
+
+    void messageReceived(const juce::MemoryBlock& data) override
+    {
+        const juce::var message = DaemonProtocol::decode(data);
+        const juce::String type = message["type"].toString();
+        const auto id = (juce::int64)message["id"];
+
+        if (type == "cancel")
+        {
+            std::lock_guard<std::mutex> sl(lock);
+            cancelled.insert(id);
+            return;
+        }
+
+        if (type != "generate")
+            return;
+
+        const auto imagePath = message["image"].toString();
+        if (!juce::File::isAbsolutePath(imagePath))
+            return;
+
+        const juce::File imageFile(imagePath);
+        const GenerationParameters params = DaemonProtocol::parametersFromVar(message["params"]);
+
+        daemon.pool.addJob([self = shared_from_this(), id, imageFile, params]
+            {
+                self->generate(id, imageFile, params);
+                return juce::ThreadPoolJob::jobHasFinished;
+            });
+    }
+
+private:
+    bool isCancelled(juce::int64 id)
+    {
+        std::lock_guard<std::mutex> sl(lock);
+        return closed || cancelled.count(id) > 0;
+    }
+
+    void forget(juce::int64 id)
+    {
+        std::lock_guard<std::mutex> sl(lock);
+        cancelled.erase(id);
+    }
+
+    void send(const juce::DynamicObject::Ptr& message)
+    {
+        // A pipe whose instance has gone stops taking messages; that's the only sign of it
+        if (!closed && !sendMessage(DaemonProtocol::encode(juce::var(message.get()))))
+            close();
+    }
+
+public:
+    void sendReady()
+    {
+        juce::DynamicObject::Ptr message = new juce::DynamicObject();
+        message->setProperty("type", "ready");
+        send(message);
+    }
+
+private:
+
+    void generate(juce::int64 id, const juce::File& imageFile, const GenerationParameters& params)
+    {
+        if (isCancelled(id))
+        {
+            forget(id);
+            return;
+        }
+
+        auto graph = daemon.borrowGraph(imageFile);
+        double lastReport = 0.0;
+
+        auto sound = graph->render(imageFile, params, [this, id, &lastReport](float progress)
+            {
+                if (isCancelled(id))
+                    return false;
+
+                // A few updates a second is plenty for a progress bar
+                const double now = juce::Time::getMillisecondCounterHiRes();
+                if (now - lastReport >= 100.0)
+                {
+                    lastReport = now;
+
+                    auto message = makeMessage("progress", id);
+                    message->setProperty("progress", progress);
+                    send(message);
+                }
+
+                return true;
+            });
+
+        const juce::String colour = graph->getDominantColour();
+        daemon.returnGraph(std::move(graph));
+
+        if (isCancelled(id))
+        {
+            forget(id);
+            return;
+        }
+
+        const juce::File audioFile = DaemonProtocol::getSharedAudioFolder().getChildFile(juce::Uuid().toString() + ".audio");
+
+        if (sound == nullptr || sound->getNumSamples() == 0 || !DaemonProtocol::writeSharedAudio(*sound, audioFile))
+        {
+            send(makeMessage("failed", id));
+            return;
+        }
+
+        auto message = makeMessage("done", id);
+        message->setProperty("audio", audioFile.getFullPathName());
+        message->setProperty("colour", colour);
+        message->setProperty("sampleRate", params.sampleRate);
+
+        // Once it's been told about the file, deleting it is the instance's job
+        if (closed || !sendMessage(DaemonProtocol::encode(juce::var(message.get()))))
+        {
+            audioFile.deleteFile();
+            close();
+        }
+    }
+
+    GenerationDaemon& daemon;
+    std::atomic<bool> closed{ false };
+
+    std::mutex lock;
+    std::set<juce::int64> cancelled;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Connection)
+};
+
+//==============================================================================
+GenerationDaemon::GenerationDaemon(int numWorkers)
+    : juce::Thread("Generation daemon"), pool(juce::jmax(1, numWorkers))
+{
+}
+
+GenerationDaemon::~GenerationDaemon()
+{
+    stop();
+}
+
+bool GenerationDaemon::start()
+{
+    if (!runningLock.enter(0))
+        return false;
+
+    if (!DaemonProtocol::createPrivateFolder(DaemonProtocol::getConnectFolder())
+        || !DaemonProtocol::createPrivateFolder(DaemonProtocol::getSharedAudioFolder()))
+    {
+        runningLock.exit();
+        return false;
+    }
+
+    // Anything left behind by instances that crashed before collecting their audio
+    for (const auto& file : DaemonProtocol::getSharedAudioFolder().findChildFiles(juce::File::findFiles, false, "*.audio"))
+        if (file.getLastModificationTime() < juce::Time::getCurrentTime() - juce::RelativeTime::hours(1))
+            file.deleteFile();
+
+    // Requests from before this daemon started have long since timed out
+    for (const auto& file : DaemonProtocol::getConnectFolder().findChildFiles(juce::File::findFiles, false, "*.connect"))
+        file.deleteFile();
+
+    running = true;
+    startThread();
+    return true;
+}
+
+void GenerationDaemon::stop()
+{
+    if (!running)
+        return;
+
+    stopThread(5000);
+
+    {
+        std::lock_guard<std::mutex> sl(connectionsLock);
+        for (auto& connection : connections)
+            connection->close();
+    }
+
+    pool.removeAllJobs(true, 30000);
+
+    {
+        std::lock_guard<std::mutex> sl(connectionsLock);
+        connections.clear();
+    }
+
+    runningLock.exit();
+    running = false;
+}
+
+void GenerationDaemon::run()
+{
+    const auto folder = DaemonProtocol::getConnectFolder();
+
+    while (!threadShouldExit())
+    {
+        for (const auto& request : folder.findChildFiles(juce::File::findFiles, false, "*.connect"))
+        {
+            const auto id = request.getFileNameWithoutExtension();
+            request.deleteFile();
+
+            // Ids are Uuid strings; anything else isn't from an instance
+            if (id.isNotEmpty() && id.containsOnly("0123456789abcdef"))
+                accept(id);
+        }
+
+        wait(pollIntervalMs);
+    }
+}
+
+void GenerationDaemon::accept(const juce::String& connectionId)
+{
+    auto connection = std::make_shared<Connection>(*this);
+
+    if (!connection->connectToPipe(DaemonProtocol::getPipeName(connectionId), -1))
+        return;
+
+    connection->sendReady();
+
+    std::lock_guard<std::mutex> sl(connectionsLock);
+
+    connections.erase(std::remove_if(connections.begin(), connections.end(),
+                                     [](const auto& c) { return c->isClosed(); }),
+                      connections.end());
+
+    connections.push_back(std::move(connection));
+}
+
+std::unique_ptr<GenerationGraph> GenerationDaemon::borrowGraph(const juce::File& imageFile)
+{
+    std::lock_guard<std::mutex> sl(graphsLock);
+
+    if (idleGraphs.empty())
+        return std::make_unique<GenerationGraph>();
+
+    // A graph that rendered this image last time still has its features and tones
+    auto match = std::find_if(idleGraphs.begin(), idleGraphs.end(),
+                              [&imageFile](const auto& graph) { return graph->getImageFile() == imageFile; });
+
+    if (match == idleGraphs.end())
+        match = idleGraphs.end() - 1;
+
+    auto graph = std::move(*match);
+    idleGraphs.erase(match);
+    return graph;
+}
+
+void GenerationDaemon::returnGraph(std::unique_ptr<GenerationGraph> graph)
+{
+    std::lock_guard<std::mutex> sl(graphsLock);
+    idleGraphs.push_back(std::move(graph));
+}
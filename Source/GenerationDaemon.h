@@ -0,0 +1,66 @@
+/*
+  ==============================================================================
+
+    GenerationDaemon.h
+    Created: 18 Oct 2026 7:16:07am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "DaemonProtocol.h"
+#include "GenerationGraph.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//==============================================================================
+/**
+    Local generation server shared by every plugin instance on the machine
+    (run as `ImagineRenderer --daemon`).
+
+    Instances connect through a named pipe each (see DaemonProtocol) and send
+    render requests; these run on a pool with one worker per core, so several
+    instances generate in parallel outside the host's process. Each worker
+    borrows a GenerationGraph, preferring one that already holds the requested
+    image, so repeated renders of the same image keep their memoized stages.
+    Rendered audio is returned through shared memory.
+
+    A background thread watches DaemonProtocol::getConnectFolder() and opens
+    the pipe of every instance that asks.
+*/
+class GenerationDaemon : private juce::Thread
+{
+public:
+    explicit GenerationDaemon(int numWorkers = juce::SystemStats::getNumCpus());
+    ~GenerationDaemon() override;
+
+    // False if another daemon is already running for this user
+    bool start();
+    void stop();
+
+    static constexpr int pollIntervalMs = 20;
+
+private:
+    class Connection;
+
+    void run() override;
+    void accept(const juce::String& connectionId);
+
+    std::unique_ptr<GenerationGraph> borrowGraph(const juce::File& imageFile);
+    void returnGraph(std::unique_ptr<GenerationGraph> graph);
+
+    juce::ThreadPool pool;
+    juce::InterProcessLock runningLock{ DaemonProtocol::daemonLockName };
+    bool running = false;
+
+    std::mutex connectionsLock;
+    std::vector<std::shared_ptr<Connection>> connections;
+
+    std::mutex graphsLock;
+    std::vector<std::unique_ptr<GenerationGraph>> idleGraphs;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GenerationDaemon)
+};
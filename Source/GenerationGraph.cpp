@@ -0,0 +1,324 @@
+/*
+  ==============================================================================
+
+    GenerationGraph.cpp
+    Created: 18 Oct 2026 7:02:49am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#include "GenerationGraph.h"
+#include "ExtendedFeatures.h"
+#include "TiledImageReader.h"
+#include <cmath>
+#include <limits>
+
+void GenerationGraph::setSource(const juce::File& imageFile)
+{
+    const StageKey key{ (double)imageFile.getLastModificationTime().toMilliseconds(), (double)imageFile.getSize() };
+
+    if (imageFile == currentImageFile && sourceKey == key)
+        return;
+
+    currentImageFile = imageFile;
+    sourceKey = key;
+    imageHash = {};
+    featuresKey.reset();
+    tiled = TiledImageReader::shouldUse(imageFile);
+
+    for (auto& level : pyramid)
+        level.clear();
+}
+
+const IntegralImage* GenerationGraph::getIntegral(const juce::File& imageFile, int kernelSize, int stepSize)
+{
+    setSource(imageFile);
+
+    if (tiled)
+        return nullptr;
+
+    // Same scale ImageLoader::load picks, so features don't depend on which levels exist
+    const int scale = ImageLoader::chooseScale(juce::jmax(1, kernelSize), juce::jmax(1, stepSize));
+    int level = 0;
+    while ((1 << level) < scale)
+        ++level;
+
+    auto& integral = pyramid[(size_t)level];
+
+    if (integral.isEmpty())
+    {
+        // Derive from the nearest finer level if there is one, otherwise decode at this scale
+        for (int finer = level - 1; finer >= 0 && integral.isEmpty(); --finer)
+            if (!pyramid[(size_t)finer].isEmpty())
+                integral.buildDownsampled(pyramid[(size_t)finer], 1 << (level - finer));
+
+        if (integral.isEmpty())
+            integral.build(ImageLoader::load(imageFile, kernelSize, stepSize));
+    }
+
+    return integral.isEmpty() ? nullptr : &integral;
+}
+
+const FeatureChannels* GenerationGraph::getFeatures(const juce::File& imageFile, int kernelSize, int stepSize, TraversalOrder order,
+                                                     bool extended)
+{
+    setSource(imageFile);
+
+    // Tiled images have no extended features, so asking for them changes nothing
+    extended = extended && !tiled;
+    const StageKey key{ (double)kernelSize, (double)stepSize, (double)order, extended ? 1.0 : 0.0 };
+
+    if (featuresKey != key)
+    {
+        features = {};
+        cachedFeatures.reset();
+        computedFeatures = {};
+        ++featuresVersion;
+
+        if (imageHash.isEmpty())
+            imageHash = FeatureCache::hashImage(imageFile);
+
+        // A cache hit skips decoding and convolution altogether
+        cachedFeatures = cache.find(imageHash, kernelSize, stepSize, order, extended);
+
+        if (cachedFeatures != nullptr)
+        {
+            features = cachedFeatures->getChannels();
+        }
+        else
+        {
+            try
+            {
+                // The extended features are taken from the pyramid level's samples,
+                // so the file is decoded at most once whatever is asked for
+                if (tiled)
+                    computedFeatures = TiledImageReader::computeBlockMeans(imageFile, kernelSize, stepSize, order);
+                else if (const IntegralImage* integral = getIntegral(imageFile, kernelSize, stepSize))
+                    computedFeatures = extended ? ExtendedFeatureExtractor::compute(integral->toPlanarImage(), kernelSize, stepSize, order)
+                                                : integral->computeBlockMeans(kernelSize, stepSize, order);
+
+                if (!computedFeatures.isEmpty())
+                {
+                    features = computedFeatures.getChannels();
+                    cache.store(imageHash, kernelSize, stepSize, computedFeatures, order);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                juce::ignoreUnused(e);
+                DBG("Feature extraction failed: " << e.what());
+            }
+        }
+
+        featuresKey = key;
+    }
+
+    return features.isEmpty() ? nullptr : &features;
+}
+
+bool GenerationGraph::runStage(BufferStage& stage, const StageKey& key, const std::function<void(float*, int64_t, int)>& process,
+                               const std::function<bool(int64_t)>& onBlock)
+{
+    const int64_t length = engine.getTotalLength();
+
+    stage.key.reset();
+    stage.samples.resize((size_t)length);
+
+    for (int64_t start = 0; start < length; start += ImageSynthEngine::defaultBlockSize)
+    {
+        const int numSamples = (int)juce::jmin((int64_t)ImageSynthEngine::defaultBlockSize, length - start);
+        process(stage.samples.data() + start, start, numSamples);
+
+        if (!onBlock(start + numSamples))
+            return false;
+    }
+
+    stage.key = key;
+    return true;
+}
+
+std::shared_ptr<juce::AudioBuffer<float>> GenerationGraph::render(const juce::File& imageFile, const GenerationParameters& params,
+                                                                  const ImageSynthEngine::ProgressCallback& onProgress)
+{
+    const FeatureChannels* source = getFeatures(imageFile, params.kernelSize, params.stepSize, params.traversal,
+                                                params.needsExtendedFeatures());
+    if (source == nullptr)
+        return {};
+
+    // What analyse() reads: the features, the length and the LFO and overtone settings
+    const StageKey analysisKey{ featuresVersion, (double)params.soundDuration, params.sampleRate,
+                                (double)params.lfoAmountScalar, (double)params.overtoneNumScalar, (double)params.overtoneSource };
+
+    // Resets every stage's oscillators and filters; stages that are cached simply don't run.
+    // The analysis pass is skipped when none of its inputs moved.
+    const bool reuseAnalysis = analysis.has_value() && analysedKey == analysisKey;
+
+    if (!(reuseAnalysis ? engine.prepare(*source, params, *analysis) : engine.prepare(*source, params))
+        || engine.getTotalLength() > std::numeric_limits<int>::max())
+        return {};
+
+    if (!reuseAnalysis)
+    {
+        analysis = engine.getAnalysis();
+        analysedKey = analysisKey;
+    }
+
+    const int64_t length = engine.getTotalLength();
+
+    const StageKey baseKey{ featuresVersion, (double)params.soundDuration, params.sampleRate,
+                            (double)params.modulationIntensity, (double)params.modulationEnvelopeIntensity,
+                            (double)params.modulationDuration, (double)params.fmDepthSource };
+
+    const StageKey overtoneKey{ featuresVersion, (double)params.soundDuration, params.sampleRate,
+                                (double)params.overtoneNumScalar, (double)params.overtoneSource };
+
+    const bool runBase = !isCurrent(baseTone, baseKey);
+    const bool runOvertones = !isCurrent(overtones, overtoneKey);
+
+    // Progress is spread evenly over the stages that actually run; the last one always does
+    const float stagesToRun = (float)(1 + (int)runBase + (int)runOvertones);
+    float stagesDone = 0.0f;
+
+    auto onBlock = [&](int64_t done)
+    {
+        return onProgress == nullptr || onProgress((stagesDone + (float)done / (float)length) / stagesToRun);
+    };
+
+    if (runBase)
+    {
+        if (!runStage(baseTone, baseKey, [this](float* out, int64_t start, int n) { engine.modulateFrequency(out, start, n); }, onBlock))
+            return {};
+
+        stagesDone += 1.0f;
+    }
+
+    if (runOvertones)
+    {
+        auto process = [this](float* out, int64_t, int n)
+        {
+            juce::FloatVectorOperations::clear(out, n);
+            engine.applyOvertones(out, n);
+        };
+
+        if (!runStage(overtones, overtoneKey, process, onBlock))
+            return {};
+
+        stagesDone += 1.0f;
+    }
+
+    // The LFO, limiter, filter and level go straight into a fresh buffer (the previous
+    // one may still be playing) rather than into a cached copy of their own
+    auto sound = std::make_shared<juce::AudioBuffer<float>>(1, (int)length);
+    float* output = sound->getWritePointer(0);
+
+    for (int64_t start = 0; start < length; start += ImageSynthEngine::defaultBlockSize)
+    {
+        const int n = (int)juce::jmin((int64_t)ImageSynthEngine::defaultBlockSize, length - start);
+        float* out = output + start;
+
+        juce::FloatVectorOperations::add(out, baseTone.samples.data() + start, overtones.samples.data() + start, n);
+        engine.applyLfo(out, start, n);
+        engine.applyLimiter(out, n);
+        engine.lowpassFilter(out, n);
+        juce::FloatVectorOperations::multiply(out, params.soundLevel, n);
+
+        if (!onBlock(start + n))
+            return {};
+    }
+
+    if (onProgress != nullptr)
+        onProgress(1.0f);
+
+    return sound;
+}
+
+std::shared_ptr<juce::AudioBuffer<float>> GenerationGraph::renderPreview(const juce::File& imageFile, const GenerationParameters& params,
+                                                                         double maxSeconds, int resolutionFactor)
+{
+    const int previewStep = params.stepSize * juce::jmax(1, resolutionFactor);
+
+    // The pyramid is shared with full renders; the coarse block means are not.
+    // Tiled images have no pyramid, and a second pass over one is no preview.
+    const IntegralImage* integral = getIntegral(imageFile, params.kernelSize, previewStep);
+    if (integral == nullptr)
+        return {};
+
+    ImageFeatures coarse;
+    try
+    {
+        if (params.needsExtendedFeatures())
+            coarse = ExtendedFeatureExtractor::compute(integral->toPlanarImage(), params.kernelSize, previewStep, params.traversal);
+        else
+            coarse = integral->computeBlockMeans(params.kernelSize, previewStep, params.traversal);
+    }
+    catch (const std::exception& e)
+    {
+        juce::ignoreUnused(e);
+        DBG("Preview feature extraction failed: " << e.what());
+        return {};
+    }
+
+    if (coarse.isEmpty())
+        return {};
+
+    // Just the windows the first maxSeconds play, over maxSeconds, so prepare()'s
+    // analysis pass covers the preview rather than the whole duration
+    GenerationParameters previewParams = params;
+    FeatureChannels channels = coarse.getChannels();
+
+    if (params.soundDuration > maxSeconds)
+    {
+        previewParams.soundDuration = (float)maxSeconds;
+        channels.size = juce::jlimit(1, channels.size, (int)std::ceil(channels.size * maxSeconds / params.soundDuration));
+    }
+
+    ImageSynthEngine previewEngine;
+    if (!previewEngine.prepare(channels, previewParams))
+        return {};
+
+    const auto length = (int)juce::jmin(previewEngine.getTotalLength(), (int64_t)(maxSeconds * params.sampleRate));
+    if (length <= 0)
+        return {};
+
+    auto sound = std::make_shared<juce::AudioBuffer<float>>(1, length);
+    float* output = sound->getWritePointer(0);
+
+    for (int done = 0; done < length;)
+    {
+        const int written = previewEngine.renderNextBlock(output + done, juce::jmin(ImageSynthEngine::defaultBlockSize, length - done));
+        if (written <= 0)
+        {
+            sound->setSize(1, done, true);
+            break;
+        }
+
+        done += written;
+    }
+
+    return sound;
+}
+
+void GenerationGraph::clear()
+{
+    currentImageFile = juce::File();
+    imageHash = {};
+    sourceKey.reset();
+    featuresKey.reset();
+    tiled = false;
+    features = {};
+    cachedFeatures.reset();
+    computedFeatures = {};
+
+    for (auto& level : pyramid)
+        level.clear();
+
+    analysis.reset();
+    analysedKey.reset();
+
+    for (auto* stage : { &baseTone, &overtones })
+    {
+        stage->key.reset();
+        stage->samples = {};
+    }
+}
@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+
+    GenerationGraph.h
+    Created: 18 Oct 2026 7:02:49am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "ImageLoader.h"
+#include "ImageFeatures.h"
+#include "ImageSynthEngine.h"
+#include "FeatureCache.h"
+#include <array>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+//==============================================================================
+/**
+    The native generator as a graph of memoized stages for the current image:
+
+        integral -> features -> analysis
+                             -> base tone ----\
+                             -> overtones -----+-> lfo / limiter / filter / level
+
+    Each stage remembers the inputs it was last computed from and only runs
+    again when one of them changes, so moving an LFO or level slider reuses
+    the image pyramid, the block means, the engine's analysis pass and both
+    tone buffers. The last stage is cheap and writes straight into the
+    returned buffer, so it is not kept.
+
+    Features are looked up in the persistent FeatureCache before the image
+    is decoded at all; newly computed ones are stored there. When a feature
+    mapping needs the extended channels, the pyramid level's samples are run
+    through ExtendedFeatureExtractor instead, and all seven channels are cached.
+
+    The image is kept as a pyramid of summed-area tables, one per downscale
+    factor (1, 2, 4, 8). Coarser levels are derived from finer ones without
+    decoding again, so a new kernel or step size costs a table lookup per
+    window rather than a decode and convolution.
+
+    Images too large to decode (see TiledImageReader) have no pyramid, no
+    preview and no extended features: their block means are read
+    straight from the file at full resolution by TiledImageReader, once per
+    kernel and step size.
+
+    Holds two full-length float buffers between renders. Not thread safe;
+    GenerationQueue only uses it from its worker thread.
+*/
+class GenerationGraph
+{
+public:
+    GenerationGraph() = default;
+
+    // Summed-area table at the scale kernel and step need; null if the file can't be read
+    // or is too large to hold (see TiledImageReader)
+    const IntegralImage* getIntegral(const juce::File& imageFile, int kernelSize, int stepSize);
+
+    // Block means for the image; null if it can't be read or the kernel doesn't fit.
+    // With extended, also the ExtendedFeatureExtractor channels, except for tiled images.
+    const FeatureChannels* getFeatures(const juce::File& imageFile, int kernelSize, int stepSize,
+                                       TraversalOrder order = TraversalOrder::raster, bool extended = false);
+
+    // Renders the sound for the image, recomputing only the stages whose inputs
+    // changed. Returns null if the image can't be used or onProgress returns false.
+    std::shared_ptr<juce::AudioBuffer<float>> render(const juce::File& imageFile, const GenerationParameters& params,
+                                                     const ImageSynthEngine::ProgressCallback& onProgress = nullptr);
+
+    // The first maxSeconds of the sound, from features taken at resolutionFactor
+    // times the step size. Runs the engine directly and leaves every memoized
+    // stage alone, so a preview never costs the full render that follows it.
+    // The engine is prepared for maxSeconds over the windows they cover, so its
+    // means (dominant colour, overtones, LFOs) come from those windows alone.
+    std::shared_ptr<juce::AudioBuffer<float>> renderPreview(const juce::File& imageFile, const GenerationParameters& params,
+                                                            double maxSeconds, int resolutionFactor = 2);
+
+    juce::String getDominantColour() const { return engine.getDominantColour(); }
+    juce::File getImageFile() const { return currentImageFile; }
+
+    // Drops every cached stage
+    void clear();
+
+private:
+    // The values a stage was computed from, compared exactly
+    using StageKey = std::vector<double>;
+
+    struct BufferStage
+    {
+        std::vector<float> samples;
+        std::optional<StageKey> key;
+    };
+
+    bool isCurrent(const BufferStage& stage, const StageKey& key) const { return stage.key.has_value() && *stage.key == key; }
+
+    // Runs one engine stage over the whole buffer in blocks; false if abandoned
+    bool runStage(BufferStage& stage, const StageKey& key, const std::function<void(float*, int64_t, int)>& process,
+                  const std::function<bool(int64_t)>& onBlock);
+
+    // Invalidates the pyramid and feature stages when the file or its contents change
+    void setSource(const juce::File& imageFile);
+
+    ImageSynthEngine engine;
+    FeatureCache cache;
+
+    juce::File currentImageFile;
+    juce::String imageHash;             // content hash of currentImageFile, computed on first use
+    std::optional<StageKey> sourceKey, featuresKey;
+    bool tiled = false;                 // too large to decode, so features come from TiledImageReader
+    std::array<IntegralImage, 4> pyramid;       // scales 1, 2, 4, 8; built on demand
+
+    // Either mapped from the cache or computed here; features points into whichever it is
+    std::unique_ptr<FeatureCache::Entry> cachedFeatures;
+    ImageFeatures computedFeatures;
+    FeatureChannels features;
+    double featuresVersion = 0.0;       // bumped whenever features change, part of every later key
+
+    // ImageSynthEngine::analyse() from the last prepare() that ran it
+    std::optional<ImageSynthEngine::Analysis> analysis;
+    std::optional<StageKey> analysedKey;
+
+    BufferStage baseTone, overtones;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GenerationGraph)
+};
@@ -0,0 +1,329 @@
+/*
+  ==============================================================================
+
+    GenerationQueue.cpp
+    Created: 18 Oct 2026 6:53:56am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#include "GenerationQueue.h"
+#include "PluginProcessor.h"
+#include "ImageFeatures.h"
+#include "BatchConverter.h"
+
+//==============================================================================
+class GenerationQueue::Job : public juce::ThreadPoolJob
+{
+public:
+    Job(ImagineAudioProcessor& p, GenerationGraph& g, DaemonClient& d, GenerationRequest r, std::shared_ptr<GenerationHandle> h,
+        ProgressCallback progress, CompletionCallback complete)
+        : juce::ThreadPoolJob("Generate sound"),
+          processor(p), graph(g), daemon(d), request(std::move(r)), handle(std::move(h)),
+          onProgress(std::move(progress)), onComplete(std::move(complete))
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        // Superseded while it was still queued
+        if (isCancelled())
+        {
+            handle->finished = true;
+            return jobHasFinished;
+        }
+
+        GenerationResult result = request.useNativeGenerator ? generateNative() : generatePython();
+        result.cancelled = isCancelled();
+
+        handle->finished = true;
+
+        if (result.cancelled)
+            return jobHasFinished;
+
+        if (onComplete != nullptr)
+        {
+            juce::MessageManager::callAsync([h = handle, callback = onComplete, result]
+                {
+                    if (!h->isCancelled())
+                        callback(result);
+                });
+        }
+
+        // Exporting happens after the sound has been handed over
+        if (result.sound != nullptr && request.exportFile)
+            exportSound(result);
+
+        return jobHasFinished;
+    }
+
+private:
+    bool isCancelled() const { return shouldExit() || handle->isCancelled(); }
+
+    // Renders report after every block; the message thread only hears about a
+    // new stage, the end, or every reportIntervalMs
+    void report(GenerationStage stage, float progress)
+    {
+        if (isCancelled() || onProgress == nullptr)
+            return;
+
+        const double now = juce::Time::getMillisecondCounterHiRes();
+        if (stage == lastReportedStage && progress < 1.0f && now - lastReportTime < reportIntervalMs)
+            return;
+
+        lastReportedStage = stage;
+        lastReportTime = now;
+
+        juce::MessageManager::callAsync([h = handle, callback = onProgress, stage, progress]
+            {
+                if (!h->isCancelled())
+                    callback(stage, progress);
+            });
+    }
+
+    bool exportSound(const GenerationResult& result)
+    {
+        const juce::File outputFile(request.outputPath + result.name.toStdString() + ".wav");
+        return BatchConverter::writeWavFile(*result.sound, outputFile, result.sampleRate);
+    }
+
+    GenerationResult generateNative()
+    {
+        const juce::File source(request.imagePath);
+        const auto& params = request.params;
+
+        GenerationResult result;
+        result.sampleRate = params.sampleRate;
+
+        if (source.isDirectory())
+            return convertFolder(source);
+
+        if (!source.existsAsFile())
+            return result;
+
+        if (!request.sweep.empty())
+            return sweep(source);
+
+        // Previews are short enough that a round trip to the daemon would only add to them
+        if (request.previewSeconds > 0.0)
+        {
+            result.sound = graph.renderPreview(source, params, request.previewSeconds);
+            result.name = source.getFileNameWithoutExtension() + "_preview";
+            return result;
+        }
+
+        // A running daemon renders out of process, in parallel with other instances.
+        // If it fails, the render simply happens here instead.
+        if (daemon.connect())
+        {
+            report(GenerationStage::synthesising, 0.0f);
+
+            auto remote = daemon.generate(source, params, [this](float fraction)
+                {
+                    report(GenerationStage::synthesising, fraction);
+                    return !isCancelled();
+                });
+
+            if (isCancelled())
+                return result;
+
+            if (remote)
+            {
+                result.sound = std::move(remote->sound);
+                result.sampleRate = remote->sampleRate;
+                result.name = source.getFileNameWithoutExtension() + "_output_" + remote->dominantColour;
+                return result;
+            }
+        }
+
+        // Each graph call returns straight away when its stage is already cached
+        report(GenerationStage::extractingFeatures, 0.0f);
+        if (graph.getFeatures(source, params.kernelSize, params.stepSize, params.traversal, params.needsExtendedFeatures()) == nullptr)
+        {
+            DBG("Could not extract features: " << source.getFullPathName());
+            return result;
+        }
+
+        if (isCancelled())
+            return result;
+
+        auto sound = graph.render(source, params, [this](float fraction)
+            {
+                report(GenerationStage::synthesising, 0.2f + 0.8f * fraction);
+                return !isCancelled();
+            });
+
+        if (sound == nullptr || sound->getNumSamples() == 0 || isCancelled())
+            return result;
+
+        result.sound = std::move(sound);
+        result.name = source.getFileNameWithoutExtension() + "_output_" + graph.getDominantColour();
+        return result;
+    }
+
+    // Folders go through the parallel pipeline straight to WAV files. The last
+    // image's file is reported back, to be loaded like main_generation_handler's output.
+    GenerationResult convertFolder(const juce::File& folder)
+    {
+        GenerationResult result;
+        result.sampleRate = request.params.sampleRate;
+
+        auto imageFiles = folder.findChildFiles(juce::File::findFiles, false, "*.jpg");
+        imageFiles.addArray(folder.findChildFiles(juce::File::findFiles, false, "*.png"));
+
+        report(GenerationStage::synthesising, 0.0f);
+
+        auto options = BatchConverter::Options::forThisMachine();
+        options.autoResolutionFeatures = request.autoResolutionFeatures;
+
+        BatchConverter converter(options);
+        converter.shouldStop = [this] { return isCancelled(); };
+
+        const auto written = converter.run(imageFiles, request.outputPath, request.params, [this](int done, int total)
+            {
+                report(GenerationStage::synthesising, (float)done / (float)total);
+                return !isCancelled();
+            });
+
+        if (!written.empty())
+            result.outputFile = written.back();
+
+        return result;
+    }
+
+    // Every variant is written as it finishes; the first one's file is handed
+    // back to be loaded and played
+    GenerationResult sweep(const juce::File& source)
+    {
+        GenerationResult result;
+        result.sampleRate = request.params.sampleRate;
+
+        report(GenerationStage::synthesising, 0.0f);
+
+        const auto variants = ParameterSweep::render(source, ParameterSweep::expand(request.params, request.sweep),
+            request.outputPath, [this](float fraction)
+            {
+                report(GenerationStage::synthesising, fraction);
+                return !isCancelled();
+            });
+
+        if (isCancelled())
+            return result;
+
+        for (const auto& variant : variants)
+        {
+            if (variant.file != juce::File())
+            {
+                result.outputFile = variant.file;
+                result.sampleRate = variant.params.sampleRate;
+                result.name = source.getFileNameWithoutExtension() + "_output_" + variant.dominantColour;
+                break;
+            }
+        }
+
+        return result;
+    }
+
+    GenerationResult generatePython()
+    {
+        // The interpreter can't be interrupted mid-call, so cancellation only
+        // takes effect once the generator returns
+        report(GenerationStage::synthesising, 0.0f);
+
+        const auto& params = request.params;
+        return processor.callPythonFunction(request.imagePath,
+            request.outputPath,
+            params.kernelSize,
+            params.stepSize,
+            (int)params.soundLevel,
+            (int)params.soundDuration,
+            (int)params.modulationDuration,
+            params.modulationIntensity,
+            params.modulationEnvelopeIntensity,
+            params.overtoneNumScalar,
+            params.lfoScalarFreq,
+            params.lfoScalarAmplitude,
+            params.lfoIntensity,
+            params.lfoAmountScalar);
+    }
+
+    ImagineAudioProcessor& processor;
+    GenerationGraph& graph;
+    DaemonClient& daemon;
+    GenerationRequest request;
+    std::shared_ptr<GenerationHandle> handle;
+    ProgressCallback onProgress;
+    CompletionCallback onComplete;
+
+    static constexpr double reportIntervalMs = 50.0;
+    GenerationStage lastReportedStage{};
+    double lastReportTime = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Job)
+};
+
+//==============================================================================
+GenerationQueue::GenerationQueue(ImagineAudioProcessor& p)
+    : processor(p)
+{
+}
+
+GenerationQueue::~GenerationQueue()
+{
+    cancelAll();
+
+    // A Python render can't be interrupted, so give it time to return
+    pool.removeAllJobs(true, 30000);
+}
+
+std::shared_ptr<GenerationHandle> GenerationQueue::submit(GenerationRequest request,
+                                                          ProgressCallback onProgress,
+                                                          CompletionCallback onComplete)
+{
+    cancelAll();
+
+    currentHandle = std::make_shared<GenerationHandle>();
+    pool.addJob(new Job(processor, graph, daemon, std::move(request), currentHandle,
+                        std::move(onProgress), std::move(onComplete)), true);
+
+    return currentHandle;
+}
+
+std::shared_ptr<GenerationHandle> GenerationQueue::submitLive(GenerationRequest request,
+                                                              ProgressCallback onProgress,
+                                                              CompletionCallback onComplete)
+{
+    // A queued live job is left in the pool and returns as soon as it starts
+    if (liveHandle != nullptr)
+        liveHandle->cancel();
+
+    liveHandle = std::make_shared<GenerationHandle>();
+    pool.addJob(new Job(processor, graph, daemon, std::move(request), liveHandle,
+                        std::move(onProgress), std::move(onComplete)), true);
+
+    return liveHandle;
+}
+
+void GenerationQueue::preload(const juce::File& imageFile, int kernelSize, int stepSize)
+{
+    // Runs on the pool's thread like any generation job, so the graph is never shared
+    pool.addJob([this, imageFile, kernelSize, stepSize]
+        {
+            graph.getIntegral(imageFile, kernelSize, stepSize);
+            return juce::ThreadPoolJob::jobHasFinished;
+        });
+}
+
+void GenerationQueue::cancelAll()
+{
+    if (currentHandle != nullptr)
+        currentHandle->cancel();
+
+    if (liveHandle != nullptr)
+        liveHandle->cancel();
+
+    // Queued jobs are deleted; the running one sees shouldExit() and stops at
+    // its next check, before the next job starts on the same thread
+    pool.removeAllJobs(true, 0);
+}
@@ -0,0 +1,119 @@
+/*
+  ==============================================================================
+
+    GenerationQueue.h
+    Created: 18 Oct 2026 6:53:56am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "ImageSynthEngine.h"
+#include "GenerationGraph.h"
+#include "DaemonClient.h"
+#include "ParameterSweep.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+
+class ImagineAudioProcessor;
+
+enum class GenerationStage
+{
+    loadingImage,
+    extractingFeatures,
+    synthesising,
+    writing
+};
+
+struct GenerationRequest
+{
+    std::string imagePath;          // a jpg/png or a folder of them
+    std::string outputPath;         // folder prefix, as passed to main_generation_handler
+    GenerationParameters params;
+    bool useNativeGenerator = true;
+    bool exportFile = false;        // also write {outputPath}{name}.wav; folders are always written to files
+    double previewSeconds = 0.0;    // if > 0, a quick native render of just the start (see GenerationGraph::renderPreview)
+    std::vector<ParameterSweep::Axis> sweep;    // if set, every combination is rendered and written (see ParameterSweep)
+    int autoResolutionFeatures = 0; // folders: if > 0, kernel and step are chosen per image (see AutoResolution)
+};
+
+struct GenerationResult
+{
+    std::shared_ptr<juce::AudioBuffer<float>> sound;   // null if the generator only wrote files
+    double sampleRate = 44100.0;
+    juce::String name;              // "{image}_output_{colour}", the export file name
+    juce::File outputFile;          // last file written, if any
+    bool cancelled = false;
+};
+
+// Returned by GenerationQueue::submit(). Thread safe.
+class GenerationHandle
+{
+public:
+    void cancel() { cancelled = true; }
+    bool isCancelled() const { return cancelled; }
+    bool isFinished() const { return finished; }
+
+private:
+    friend class GenerationQueue;
+
+    std::atomic<bool> cancelled{ false };
+    std::atomic<bool> finished{ false };
+};
+
+//==============================================================================
+/**
+    Runs generation requests on a background thread, one at a time.
+
+    Submitting a request cancels whatever is running or queued (latest wins).
+    Live mode's renders only supersede each other, so they never cancel a
+    Generate or a preload; they simply queue behind it. Progress and
+    completion callbacks are delivered on the message thread, and never for
+    a job that has been superseded or cancelled.
+
+    Native renders of a single image go through a GenerationGraph that lives
+    as long as the queue, so regenerating after a slider change only reruns
+    the stages that depend on it. If a GenerationDaemon is running they are
+    sent there instead, and the graph is only the fallback.
+*/
+class GenerationQueue
+{
+public:
+    using ProgressCallback = std::function<void(GenerationStage stage, float progress)>;
+    using CompletionCallback = std::function<void(const GenerationResult& result)>;
+
+    explicit GenerationQueue(ImagineAudioProcessor& processor);
+    ~GenerationQueue();
+
+    std::shared_ptr<GenerationHandle> submit(GenerationRequest request,
+                                             ProgressCallback onProgress,
+                                             CompletionCallback onComplete);
+
+    // Like submit(), but only cancels earlier submitLive() requests
+    std::shared_ptr<GenerationHandle> submitLive(GenerationRequest request,
+                                                 ProgressCallback onProgress,
+                                                 CompletionCallback onComplete);
+
+    // Cancels the running job and drops any queued ones
+    void cancelAll();
+
+    // Decodes a newly dropped image and builds its summed-area table in the
+    // background, so the first Generate and later kernel/step changes skip it
+    void preload(const juce::File& imageFile, int kernelSize, int stepSize);
+
+    bool isBusy() const { return pool.getNumJobs() > 0; }
+
+private:
+    class Job;
+
+    ImagineAudioProcessor& processor;
+    juce::ThreadPool pool{ 1 };
+    GenerationGraph graph;          // only touched by the pool's single thread
+    DaemonClient daemon;            // likewise
+    std::shared_ptr<GenerationHandle> currentHandle, liveHandle;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GenerationQueue)
+};
@@ -0,0 +1,253 @@
+/*
+  ==============================================================================
+
+    ImageFeatures.cpp
+    Created: 18 Oct 2026 6:47:11am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#include "ImageFeatures.h"
+#include "ImageLoader.h"
+#include "ParallelFor.h"
+#include <stdexcept>
+
+void IntegralImage::clear()
+{
+    width = 0;
+    height = 0;
+    scale = 1;
+    for (auto& table : tables)
+        table = {};
+}
+
+void IntegralImage::allocate(int newWidth, int newHeight, int newScale)
+{
+    clear();
+    width = newWidth;
+    height = newHeight;
+    scale = newScale;
+
+    const size_t tableSize = (size_t)(width + 1) * (size_t)(height + 1);
+    for (auto& table : tables)
+        table.assign(tableSize, 0);
+}
+
+void IntegralImage::build(const std::array<ChannelView, 3>& channels, int newWidth, int newHeight)
+{
+    if (newWidth <= 0 || newHeight <= 0)
+    {
+        clear();
+        return;
+    }
+
+    allocate(newWidth, newHeight, 1);
+
+    for (int c = 0; c < 3; ++c)
+        buildTable(c, channels[c].data, (size_t)channels[c].pixelStride, (size_t)channels[c].rowStride);
+}
+
+void IntegralImage::build(const PlanarImage& image)
+{
+    if (image.isEmpty())
+    {
+        clear();
+        return;
+    }
+
+    allocate(image.width, image.height, image.scale);
+
+    for (int c = 0; c < 3; ++c)
+        buildTable(c, image.planes[c].data(), 1, (size_t)image.width);
+}
+
+void IntegralImage::buildDownsampled(const IntegralImage& source, int factor)
+{
+    jassert(this != &source);
+
+    factor = juce::jmax(1, factor);
+    const int newWidth = source.width / factor;
+    const int newHeight = source.height / factor;
+
+    if (newWidth <= 0 || newHeight <= 0)
+    {
+        clear();
+        return;
+    }
+
+    allocate(newWidth, newHeight, source.scale * factor);
+
+    // Entry (x, y) sums everything above and left of (x * scale, y * scale) in source
+    // pixels, which the finer table already holds at (x * factor, y * factor)
+    for (int c = 0; c < 3; ++c)
+    {
+        for (int y = 0; y <= height; ++y)
+        {
+            const uint32_t* in = source.tables[c].data() + source.tableIndex(0, y * factor);
+            uint32_t* out = tables[c].data() + tableIndex(0, y);
+
+            for (int x = 0; x <= width; ++x)
+                out[x] = in[(size_t)x * (size_t)factor];
+        }
+    }
+}
+
+PlanarImage IntegralImage::toPlanarImage() const
+{
+    PlanarImage image;
+    if (isEmpty())
+        return image;
+
+    image.width = width;
+    image.height = height;
+    image.scale = scale;
+
+    for (int c = 0; c < 3; ++c)
+    {
+        auto& plane = image.planes[(size_t)c];
+        plane.resize((size_t)width * (size_t)height);
+
+        parallelFor(0, height, 64, [&](int rowBegin, int rowEnd)
+            {
+                for (int y = rowBegin; y < rowEnd; ++y)
+                {
+                    const uint32_t* above = tables[(size_t)c].data() + tableIndex(0, y);
+                    const uint32_t* row = tables[(size_t)c].data() + tableIndex(0, y + 1);
+                    uint16_t* out = plane.data() + (size_t)y * (size_t)width;
+
+                    // A sample is at most 255 * 8 * 8, so it fits whatever the totals wrapped to
+                    for (int x = 0; x < width; ++x)
+                        out[x] = (uint16_t)(row[x + 1] - row[x] - above[x + 1] + above[x]);
+                }
+            });
+    }
+
+    return image;
+}
+
+template <typename SampleType>
+void IntegralImage::buildTable(int channel, const SampleType* data, size_t pixelStride, size_t rowStride)
+{
+    auto& table = tables[channel];
+
+    // Pass 1: prefix sums along each row, rows split across cores
+    parallelFor(0, height, 64, [&](int rowBegin, int rowEnd)
+        {
+            for (int y = rowBegin; y < rowEnd; ++y)
+            {
+                const SampleType* src = data + (size_t)y * rowStride;
+                uint32_t* dst = table.data() + tableIndex(0, y + 1);
+                uint32_t running = 0;
+
+                for (int x = 0; x < width; ++x)
+                {
+                    running += src[(size_t)x * pixelStride];
+                    dst[x + 1] = running;
+                }
+            }
+        });
+
+    // Pass 2: accumulate down the columns, column bands split across cores
+    parallelFor(1, width + 1, 256, [&](int colBegin, int colEnd)
+        {
+            for (int y = 1; y < height; ++y)
+            {
+                const uint32_t* above = table.data() + tableIndex(0, y);
+                uint32_t* row = table.data() + tableIndex(0, y + 1);
+
+                for (int x = colBegin; x < colEnd; ++x)
+                    row[x] += above[x];
+            }
+        });
+}
+
+uint32_t IntegralImage::getSum(int channel, int x, int y, int w, int h) const
+{
+    const auto& table = tables[channel];
+    return table[tableIndex(x + w, y + h)] - table[tableIndex(x, y + h)]
+         - table[tableIndex(x + w, y)] + table[tableIndex(x, y)];
+}
+
+ImageFeatures IntegralImage::computeBlockMeans(int kernelSize, int stepSize, TraversalOrder order) const
+{
+    if (isEmpty())
+        throw std::invalid_argument("Image cannot be null");
+
+    if (kernelSize <= 0 || stepSize <= 0)
+        throw std::invalid_argument("Kernel size and step size must be positive");
+
+    if (kernelSize > height * scale || kernelSize > width * scale)
+        throw std::invalid_argument("Kernel size cannot be larger than the image");
+
+    if (kernelSize % scale != 0 || stepSize % scale != 0)
+        throw std::invalid_argument("Kernel size and step size must be multiples of the image scale");
+
+    // Work in table samples; the window sum still covers kernelSize^2 source pixels
+    const int kernel = kernelSize / scale;
+    const int step = stepSize / scale;
+
+    const int numRows = (height - kernel) / step + 1;
+    const int numCols = (width - kernel) / step + 1;
+    const size_t numWindows = (size_t)numRows * (size_t)numCols;
+
+    ImageFeatures features;
+    features.red.resize(numWindows);
+    features.green.resize(numWindows);
+    features.blue.resize(numWindows);
+
+    std::array<float*, 3> outputs{ features.red.data(), features.green.data(), features.blue.data() };
+    const double windowArea = (double)kernelSize * (double)kernelSize;
+
+    auto windowMean = [&](int c, int row, int col)
+    {
+        const double mean = getSum(c, col * step, row * step, kernel, kernel) / windowArea;
+
+        // Matches (np.mean(window) + 1e-12) / 256 in image_convolution
+        return (float)((mean + 0.000000000001) / 256.0);
+    };
+
+    if (order == TraversalOrder::raster)
+    {
+        parallelFor(0, numRows, 16, [&](int rowBegin, int rowEnd)
+            {
+                for (int r = rowBegin; r < rowEnd; ++r)
+                {
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        float* out = outputs[c] + (size_t)r * (size_t)numCols;
+
+                        for (int col = 0; col < numCols; ++col)
+                            out[col] = windowMean(c, r, col);
+                    }
+                }
+            });
+
+        return features;
+    }
+
+    // Tile by tile rather than in the order's own sequence: the table rows a tile
+    // reads stay in cache, and each mean is written once, straight to its rank
+    const auto ranks = WindowTraversal::computeRanks(order, numRows, numCols);
+    const int tile = WindowTraversal::tileWindows;
+    const int tileCols = (numCols + tile - 1) / tile;
+    const int numTiles = ((numRows + tile - 1) / tile) * tileCols;
+
+    parallelFor(0, numTiles, 4, [&](int tileBegin, int tileEnd)
+        {
+            for (int t = tileBegin; t < tileEnd; ++t)
+            {
+                const int rowBegin = (t / tileCols) * tile;
+                const int colBegin = (t % tileCols) * tile;
+                const int rowEnd = juce::jmin(numRows, rowBegin + tile);
+                const int colEnd = juce::jmin(numCols, colBegin + tile);
+
+                for (int c = 0; c < 3; ++c)
+                    for (int r = rowBegin; r < rowEnd; ++r)
+                        for (int col = colBegin; col < colEnd; ++col)
+                            outputs[c][(size_t)WindowTraversal::getRank(ranks, r, col, numCols)] = windowMean(c, r, col);
+            }
+        });
+
+    return features;
+}
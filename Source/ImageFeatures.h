@@ -0,0 +1,134 @@
+/*
+  ==============================================================================
+
+    ImageFeatures.h
+    Created: 18 Oct 2026 6:47:11am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "WindowTraversal.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+struct PlanarImage;
+
+// Per-window features beyond the colour means, all in [0, 1]. Only
+// ExtendedFeatureExtractor produces them (see ExtendedFeatures.h).
+enum class ExtendedFeature
+{
+    saturation,             // HSV saturation
+    value,                  // HSV value, i.e. brightness
+    luminanceVariance,      // variance of Rec. 601 luma, times 4
+    edgeDensity             // fraction of pixels on a Sobel edge
+};
+
+// Read-only view of per-window colour means: red, green, blue. Points into an
+// ImageFeatures or into a FeatureCache entry mapped from disk. The extended
+// channels are null unless they were extracted.
+struct FeatureChannels
+{
+    std::array<const float*, 3> channels{};
+    int size = 0;
+    std::array<const float*, 4> extended{};
+
+    bool isEmpty() const { return size == 0; }
+    bool hasExtended() const { return extended[0] != nullptr; }
+    const float* operator[](int channel) const { return channels[(size_t)channel]; }
+    const float* get(ExtendedFeature feature) const { return extended[(size_t)feature]; }
+};
+
+// Per-window colour means, one entry per kernel window in the order it was
+// extracted in (see WindowTraversal). In raster order, the same values as the
+// rgb_dict image_convolution builds: keys '1', '2', '3'.
+struct ImageFeatures
+{
+    std::vector<float> red;
+    std::vector<float> green;
+    std::vector<float> blue;
+
+    // Empty, or one per window like the means
+    std::array<std::vector<float>, 4> extended;
+
+    int size() const { return (int)red.size(); }
+    bool isEmpty() const { return red.empty(); }
+    bool hasExtended() const { return !extended[0].empty(); }
+
+    FeatureChannels getChannels() const
+    {
+        FeatureChannels result{ { red.data(), green.data(), blue.data() }, size() };
+
+        if (hasExtended())
+            for (size_t f = 0; f < extended.size(); ++f)
+                result.extended[f] = extended[f].data();
+
+        return result;
+    }
+};
+
+// One colour channel of an 8 bit image, addressed with byte strides so that
+// interleaved (numpy HxWx3, juce::Image) and planar buffers can both be read.
+struct ChannelView
+{
+    const uint8_t* data = nullptr;
+    int pixelStride = 1;
+    int rowStride = 0;
+};
+
+//==============================================================================
+/**
+    Summed-area table for the three colour channels of an image.
+
+    Built once per image, after which the mean of any kernel x kernel window
+    costs four lookups instead of a pass over the window. Tables are kept as
+    uint32 and rely on wrap-around arithmetic: a window sum is at most
+    255 * kernel^2, so the difference of four corners is exact even when the
+    running totals overflow.
+*/
+class IntegralImage
+{
+public:
+    IntegralImage() = default;
+
+    void build(const std::array<ChannelView, 3>& channels, int width, int height);
+    void build(const PlanarImage& image);
+
+    // Coarser table, factor times the source's scale, taken from the source's entries
+    // without touching pixels. Same result as building from a PlanarImage at that scale.
+    void buildDownsampled(const IntegralImage& source, int factor);
+
+    // The samples the table sums, recovered four lookups at a time: the PlanarImage
+    // ImageLoader::load would give at this scale, without decoding the file again
+    PlanarImage toPlanarImage() const;
+
+    void clear();
+
+    bool isEmpty() const { return width == 0 || height == 0; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    int getScale() const { return scale; }
+
+    // Sum of channel values inside [x, x + w) x [y, y + h), in table samples
+    uint32_t getSum(int channel, int x, int y, int w, int h) const;
+
+    // Mean of every kernelSize window stepped by stepSize, rows split across cores,
+    // laid out in the given order (see WindowTraversal). Sizes are in source pixels.
+    // Throws std::invalid_argument with the same messages as image_convolution.
+    ImageFeatures computeBlockMeans(int kernelSize, int stepSize, TraversalOrder order = TraversalOrder::raster) const;
+
+private:
+    int width = 0, height = 0;
+    int scale = 1;      // source pixels per table sample, see PlanarImage
+    std::array<std::vector<uint32_t>, 3> tables;
+
+    void allocate(int newWidth, int newHeight, int newScale);
+
+    template <typename SampleType>
+    void buildTable(int channel, const SampleType* data, size_t pixelStride, size_t rowStride);
+
+    size_t tableIndex(int x, int y) const { return (size_t)y * (size_t)(width + 1) + (size_t)x; }
+};
@@ -0,0 +1,211 @@
+/*
+  ==============================================================================
+
+    ImageLoader.cpp
+    Created: 18 Oct 2026 6:48:49am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#include "ImageLoader.h"
+#include "ParallelFor.h"
+
+int ImageLoader::chooseScale(int kernelSize, int stepSize)
+{
+    int scale = 1;
+    while (scale < 8 && kernelSize % (scale * 2) == 0 && stepSize % (scale * 2) == 0)
+        scale *= 2;
+    return scale;
+}
+
+bool ImageLoader::isSupportedImage(const juce::File& file)
+{
+    return file.hasFileExtension("jpg;jpeg;png");
+}
+
+bool ImageLoader::readSize(const juce::File& file, int& width, int& height)
+{
+    juce::FileInputStream in(file);
+    if (!in.openedOk())
+        return false;
+
+    width = height = 0;
+    uint8_t signature[8] = {};
+    in.read(signature, 8);
+
+    if (signature[0] == 0x89 && signature[1] == 'P' && signature[2] == 'N' && signature[3] == 'G')
+    {
+        // IHDR is always the first chunk: length, type, then width and height
+        in.setPosition(16);
+        width = in.readIntBigEndian();
+        height = in.readIntBigEndian();
+    }
+    else if (signature[0] == 0xff && signature[1] == 0xd8)
+    {
+        // Walk the segments up to the first start-of-frame
+        in.setPosition(2);
+
+        while (!in.isExhausted())
+        {
+            if (in.readByte() != (char)0xff)
+                continue;
+
+            const auto marker = (uint8_t)in.readByte();
+            if (marker == 0xff || marker == 0x01 || (marker >= 0xd0 && marker <= 0xd9))
+                continue;
+
+            const int length = (uint16_t)in.readShortBigEndian();
+            const bool isFrame = marker >= 0xc0 && marker <= 0xcf && marker != 0xc4 && marker != 0xc8 && marker != 0xcc;
+
+            if (isFrame)
+            {
+                in.readByte();      // precision
+                height = (uint16_t)in.readShortBigEndian();
+                width = (uint16_t)in.readShortBigEndian();
+                break;
+            }
+
+            in.skipNextBytes(length - 2);
+        }
+    }
+
+    // Anything unusual is left unread rather than decoded, since this runs where a decode would stall
+    return width > 0 && height > 0;
+}
+
+juce::Image ImageLoader::decode(const juce::File& file)
+{
+    juce::Image image = juce::ImageFileFormat::loadFrom(file);
+    if (!image.isValid())
+    {
+        DBG("Error: could not decode image " << file.getFullPathName());
+        return {};
+    }
+
+    return image;
+}
+
+juce::Image ImageLoader::decode(const juce::MemoryBlock& fileData)
+{
+    juce::Image image = juce::ImageFileFormat::loadFrom(fileData.getData(), fileData.getSize());
+    if (!image.isValid())
+    {
+        DBG("Error: could not decode image data");
+        return {};
+    }
+
+    return image;
+}
+
+juce::Image ImageLoader::decodeWithSizeLimit(const juce::File& file)
+{
+    juce::Image image = decode(file);
+
+    // Same rule (and same target size) as the PIL path in main_generation_handler
+    if (image.isValid() && exceedsSizeLimit(image.getWidth(), image.getHeight()))
+    {
+        DBG("Image dimensions are greater than 3840*2160, resizing to 3840*2160");
+        image = image.rescaled(maxSourceWidth, maxSourceHeight, juce::Graphics::highResamplingQuality);
+    }
+
+    return image;
+}
+
+PlanarImage ImageLoader::load(const juce::File& file, int kernelSize, int stepSize)
+{
+    const juce::Image image = decode(file);
+    if (!image.isValid())
+        return {};
+
+    return fromImage(image, chooseScale(juce::jmax(1, kernelSize), juce::jmax(1, stepSize)));
+}
+
+PlanarImage ImageLoader::load(const juce::MemoryBlock& fileData, int kernelSize, int stepSize)
+{
+    const juce::Image image = decode(fileData);
+    if (!image.isValid())
+        return {};
+
+    return fromImage(image, chooseScale(juce::jmax(1, kernelSize), juce::jmax(1, stepSize)));
+}
+
+PlanarImage ImageLoader::fromImage(const juce::Image& image, int scale)
+{
+    PlanarImage result;
+    if (!image.isValid())
+        return result;
+
+    scale = juce::jmax(1, scale);
+    result.scale = scale;
+    result.width = image.getWidth() / scale;
+    result.height = image.getHeight() / scale;
+
+    if (result.isEmpty())
+        return {};
+
+    const size_t planeSize = (size_t)result.width * (size_t)result.height;
+    for (auto& plane : result.planes)
+        plane.resize(planeSize);
+
+    const juce::Image::BitmapData bitmap(image, juce::Image::BitmapData::readOnly);
+    const auto format = image.getFormat();
+
+    auto readPixel = [&bitmap, format](int x, int y, uint32_t& r, uint32_t& g, uint32_t& b)
+    {
+        const uint8_t* p = bitmap.getPixelPointer(x, y);
+
+        switch (format)
+        {
+        case juce::Image::RGB:
+        {
+            const auto* rgb = reinterpret_cast<const juce::PixelRGB*>(p);
+            r += rgb->getRed(); g += rgb->getGreen(); b += rgb->getBlue();
+            break;
+        }
+        case juce::Image::ARGB:
+        {
+            // PIL's convert('RGB') drops alpha without premultiplying
+            auto argb = *reinterpret_cast<const juce::PixelARGB*>(p);
+            argb.unpremultiply();
+            r += argb.getRed(); g += argb.getGreen(); b += argb.getBlue();
+            break;
+        }
+        default:
+        {
+            const uint8_t grey = *p;
+            r += grey; g += grey; b += grey;
+            break;
+        }
+        }
+    };
+
+    uint16_t* red = result.planes[0].data();
+    uint16_t* green = result.planes[1].data();
+    uint16_t* blue = result.planes[2].data();
+
+    // Fold scale x scale blocks while converting, so the full resolution
+    // image is never copied into a second buffer
+    parallelFor(0, result.height, 16, [&](int rowBegin, int rowEnd)
+        {
+            for (int oy = rowBegin; oy < rowEnd; ++oy)
+            {
+                const size_t rowOffset = (size_t)oy * (size_t)result.width;
+
+                for (int ox = 0; ox < result.width; ++ox)
+                {
+                    uint32_t r = 0, g = 0, b = 0;
+
+                    for (int dy = 0; dy < scale; ++dy)
+                        for (int dx = 0; dx < scale; ++dx)
+                            readPixel(ox * scale + dx, oy * scale + dy, r, g, b);
+
+                    red[rowOffset + ox] = (uint16_t)r;
+                    green[rowOffset + ox] = (uint16_t)g;
+                    blue[rowOffset + ox] = (uint16_t)b;
+                }
+            }
+        });
+
+    return result;
+}
@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+    ImageLoader.h
+    Created: 18 Oct 2026 6:48:49am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Planar RGB image ready for feature extraction.
+// Each sample holds the sum of a scale x scale block of source pixels, so a
+// downscaled image still yields the exact window means of the original.
+struct PlanarImage
+{
+    int width = 0, height = 0;      // in samples
+    int scale = 1;                  // source pixels per sample, along each side
+    std::array<std::vector<uint16_t>, 3> planes;
+
+    bool isEmpty() const { return width == 0 || height == 0; }
+    int getSourceWidth() const { return width * scale; }
+    int getSourceHeight() const { return height * scale; }
+};
+
+//==============================================================================
+/**
+    Decodes JPEG/PNG files with JUCE's ImageFileFormat straight into a
+    PlanarImage, replacing the PIL open/convert/asarray/resize sequence in
+    main_generation_handler.
+*/
+class ImageLoader
+{
+public:
+    // Largest power-of-two block (up to 8) that divides both kernel and step.
+    // Folding blocks of that size keeps every window aligned to whole samples.
+    static int chooseScale(int kernelSize, int stepSize);
+
+    // Decodes the file at its native size
+    static juce::Image decode(const juce::File& file);
+
+    // The same from the file's bytes, for callers that already read them (to hash, say)
+    static juce::Image decode(const juce::MemoryBlock& fileData);
+
+    // Decodes the file and applies main_generation_handler's size limit, for
+    // Python code that expects what PIL would have produced
+    static juce::Image decodeWithSizeLimit(const juce::File& file);
+
+    static PlanarImage load(const juce::File& file, int kernelSize, int stepSize);
+    static PlanarImage load(const juce::MemoryBlock& fileData, int kernelSize, int stepSize);
+    static PlanarImage fromImage(const juce::Image& image, int scale);
+
+    static bool isSupportedImage(const juce::File& file);
+
+    // The image's own size, read from the PNG or JPEG header without decoding.
+    // False if the header can't be parsed.
+    static bool readSize(const juce::File& file, int& width, int& height);
+
+    // True if decodeWithSizeLimit() (and the PIL path) would squash the image to the size limit
+    static bool exceedsSizeLimit(int width, int height) { return height > maxSourceWidth || width > maxSourceHeight; }
+
+    // main_generation_handler forces anything over 3840 rows or 2160 columns to 3840x2160
+    static constexpr int maxSourceWidth = 3840;
+    static constexpr int maxSourceHeight = 2160;
+};
@@ -0,0 +1,429 @@
+/*
+  ==============================================================================
+
+    ImageSynthEngine.cpp
+    Created: 18 Oct 2026 6:51:43am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#include "ImageSynthEngine.h"
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    // modulate_frequency smooths the modulator with np.convolve(x, ones(50) / 50, 'same'),
+    // which for sample i averages x[i - 25 .. i + 24] with zeros past the ends
+    constexpr int smoothingLength = 50;
+    constexpr int smoothingBehind = 25;
+    constexpr int smoothingAhead = smoothingLength - smoothingBehind - 1;
+
+    // map_to_range_with_variability(x, 0, 1) with its default 0.2..30 output and exponent 2
+    double mapToRangeWithVariability(double x)
+    {
+        x = juce::jlimit(0.0, 1.0, x);
+        return 0.2 + (30.0 - 0.2) * x * x;
+    }
+}
+
+int ImageSynthEngine::roundHalfEven(double value)
+{
+    // Python's round() uses banker's rounding
+    return (int)std::nearbyint(value);
+}
+
+const float* ImageSynthEngine::getSource(const FeatureChannels& channels, FeatureSource source)
+{
+    if (source == FeatureSource::none || !channels.hasExtended())
+        return nullptr;
+
+    return channels.get((ExtendedFeature)((int)source - 1));
+}
+
+float ImageSynthEngine::interpolate(const float* values, int64_t length, int64_t index, int64_t numSamples)
+{
+    // np.interp(np.linspace(0, len - 1, numSamples), np.arange(len), values)
+    if (length == 0 || index < 0 || index >= numSamples)
+        return 0.0f;
+
+    if (length == 1 || numSamples == 1)
+        return values[0];
+
+    const double position = (double)index * (double)(length - 1) / (double)(numSamples - 1);
+    const int64_t lower = (int64_t)position;
+
+    if (lower >= length - 1)
+        return values[length - 1];
+
+    const float fraction = (float)(position - (double)lower);
+    return values[lower] + (values[lower + 1] - values[lower]) * fraction;
+}
+
+float ImageSynthEngine::oscillate(Waveform waveform, double phase, double increment)
+{
+    // Band-limited versions of signal.square, signal.sawtooth and np.sin
+    switch (waveform)
+    {
+    case Waveform::square:
+        return oscillators::square(phase, increment);
+    case Waveform::saw:
+        return oscillators::saw(phase, increment);
+    case Waveform::sine:
+    default:
+        return oscillators::fastSine((float)phase);
+    }
+}
+
+ImageSynthEngine::Analysis ImageSynthEngine::analyse(const FeatureChannels& channels, const GenerationParameters& params, int64_t numSamples) const
+{
+    Analysis analysis;
+    const int64_t length = channels.size;
+
+    auto mean = [length](const float* values)
+    {
+        double sum = 0.0;
+        for (int64_t i = 0; i < length; ++i)
+            sum += values[i];
+        return length == 0 ? 0.0 : sum / (double)length;
+    };
+
+    analysis.meanRed = mean(channels[0]);
+    analysis.meanGreen = mean(channels[1]);
+    analysis.meanBlue = mean(channels[2]);
+
+    // max() over (red, green, blue) keeps the first of equal values
+    if (analysis.meanRed >= analysis.meanGreen && analysis.meanRed >= analysis.meanBlue)
+        analysis.dominantChannel = 0;
+    else if (analysis.meanGreen >= analysis.meanBlue)
+        analysis.dominantChannel = 1;
+    else
+        analysis.dominantChannel = 2;
+
+    const double colourAverage = (analysis.meanRed + analysis.meanGreen + analysis.meanBlue) / 3.0;
+    analysis.lfoAmount = juce::jmax(0, (int)(roundHalfEven(1.0 + (5.0 - 1.0) * colourAverage) * params.lfoAmountScalar));
+
+    // One pass over the interpolated channels for every mean the stages need
+    const float* modulator = channels[analysis.dominantChannel];
+
+    const int segments = juce::jmax(1, analysis.lfoAmount);
+    std::vector<std::array<double, 3>> segmentSums((size_t)segments, { 0.0, 0.0, 0.0 });
+    std::vector<int64_t> segmentLengths((size_t)segments, 0);
+
+    // np.array_split: the first (n % k) segments get one extra sample
+    const int64_t baseLength = numSamples / segments;
+    const int64_t longSegments = numSamples % segments;
+    int segment = 0;
+    int64_t segmentEnd = baseLength + (longSegments > 0 ? 1 : 0);
+
+    double channelSums[3] = { 0.0, 0.0, 0.0 };
+    double smoothedSum = 0.0;
+
+    const float* overtoneControl = getSource(channels, params.overtoneSource);
+    double overtoneControlSum = 0.0;
+
+    for (int64_t i = 0; i < numSamples; ++i)
+    {
+        while (i >= segmentEnd && segment < segments - 1)
+        {
+            ++segment;
+            segmentEnd += baseLength + (segment < longSegments ? 1 : 0);
+        }
+
+        for (int c = 0; c < 3; ++c)
+        {
+            const double value = interpolate(channels[c], length, i, numSamples);
+            channelSums[c] += value;
+            segmentSums[(size_t)segment][(size_t)c] += value;
+        }
+        ++segmentLengths[(size_t)segment];
+
+        // Number of smoothing windows that include sample i, for np.mean(smooth_rgb)
+        const int64_t covered = juce::jmin(numSamples - 1, i + smoothingBehind) - juce::jmax((int64_t)0, i - smoothingAhead) + 1;
+        smoothedSum += interpolate(modulator, length, i, numSamples) * (double)covered;
+
+        if (overtoneControl != nullptr)
+            overtoneControlSum += interpolate(overtoneControl, length, i, numSamples);
+    }
+
+    for (int c = 0; c < 3; ++c)
+        analysis.interpolatedMean[c] = channelSums[c] / (double)numSamples;
+
+    analysis.smoothedMean = smoothedSum / ((double)smoothingLength * (double)numSamples);
+
+    // apply_lfo: waveform per segment from its dominant channel. Only the last
+    // segment's saturation survives the loop, and every LFO uses it.
+    for (int s = 0; s < analysis.lfoAmount; ++s)
+    {
+        const double length = (double)juce::jmax((int64_t)1, segmentLengths[(size_t)s]);
+        const double r = segmentSums[(size_t)s][0] / length;
+        const double g = segmentSums[(size_t)s][1] / length;
+        const double b = segmentSums[(size_t)s][2] / length;
+
+        const double maxValue = juce::jmax(r, g, b);
+        const double minValue = juce::jmin(r, g, b);
+        const double delta = maxValue - minValue;
+        const double lightness = (maxValue + minValue) / 2.0;
+
+        if (delta == 0.0)
+            analysis.lfoSaturation = 0.01;
+        else if (lightness < 0.5)
+            analysis.lfoSaturation = delta / (maxValue + minValue);
+        else
+            analysis.lfoSaturation = delta / (2.0 - maxValue - minValue);
+
+        if (maxValue == r)
+            analysis.lfoWaveforms.push_back(Waveform::square);
+        else if (maxValue == b)
+            analysis.lfoWaveforms.push_back(Waveform::sine);
+        else
+            analysis.lfoWaveforms.push_back(Waveform::saw);
+    }
+
+    // apply_overtones is always called with 'sine' overtones from modify_base_tone
+    const double brightness = (analysis.interpolatedMean[0] + analysis.interpolatedMean[1] + analysis.interpolatedMean[2]) / 3.0;
+    const int seedValue = (int)(brightness * 100.0);
+    const double intensityScale = 0.5 + 0.8 * brightness;
+
+    const double overtoneLevel = overtoneControl != nullptr ? overtoneControlSum / (double)numSamples : brightness;
+
+    analysis.overtoneAmount = juce::jmax(0, (int)(roundHalfEven(4.0 + (12.0 - 4.0) * overtoneLevel) * params.overtoneNumScalar));
+
+    for (int n = 0; n < analysis.overtoneAmount; ++n)
+    {
+        const double baseIntensity = 0.7 - (double)n / (double)analysis.overtoneAmount;
+        const double variability = (double)(seedValue % (n + 1)) / (double)(analysis.overtoneAmount + 1);
+        analysis.overtoneGains.push_back(juce::jlimit(0.0, 1.0, baseIntensity * (1.0 + variability * intensityScale)));
+    }
+
+    return analysis;
+}
+
+bool ImageSynthEngine::prepare(const FeatureChannels& newFeatures, const GenerationParameters& newParams)
+{
+    return start(newFeatures, newParams, (int64_t)std::ceil(newParams.soundDuration * newParams.sampleRate));
+}
+
+bool ImageSynthEngine::prepare(const FeatureChannels& newFeatures, const GenerationParameters& newParams, const Analysis& previous)
+{
+    return start(newFeatures, newParams, (int64_t)std::ceil(newParams.soundDuration * newParams.sampleRate), &previous);
+}
+
+bool ImageSynthEngine::start(const FeatureChannels& newFeatures, const GenerationParameters& newParams, int64_t numSamples,
+                             const Analysis* previous)
+{
+    features = {};
+    params = newParams;
+    position = 0;
+    totalLength = numSamples;
+    segmentStart = 0;
+    segmentStarted = false;
+
+    if (newFeatures.isEmpty() || totalLength <= 0 || params.sampleRate <= 0.0)
+    {
+        totalLength = 0;
+        return false;
+    }
+
+    setFeatures(newFeatures, newParams, numSamples, previous);
+
+    // Overtones n + 2 times the base frequency, evaluated together as a SIMD sine bank
+    overtones.clear();
+    for (int n = 0; n < analysis.overtoneAmount; ++n)
+        overtones.addPartial(baseFrequency * (double)(n + 2), (float)analysis.overtoneGains[(size_t)n], params.sampleRate);
+
+    basePhase = 0.0;
+    lfoPhase = 0.0;
+
+    // lowpass_filter: butter(5, 5000 Hz) as a cascade of first and second order sections
+    const float cutoff = (float)juce::jmin(lowpassCutoff, params.sampleRate * 0.45);
+    lowpass.clear();
+    for (auto* section : juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(cutoff, params.sampleRate, lowpassOrder))
+        lowpass.push_back(std::make_unique<juce::dsp::IIR::Filter<float>>(section));
+
+    segmentStarted = true;
+    return true;
+}
+
+bool ImageSynthEngine::prepareSegment(const FeatureChannels& newFeatures, const GenerationParameters& newParams, int64_t numSamples)
+{
+    if (!segmentStarted || newParams.sampleRate != params.sampleRate)
+        return start(newFeatures, newParams, numSamples);
+
+    // A bad segment leaves the previous one in place, so the caller can retry or skip it
+    if (newFeatures.isEmpty() || numSamples <= 0)
+        return false;
+
+    segmentStart += totalLength;
+    position = 0;
+    totalLength = numSamples;
+
+    setFeatures(newFeatures, newParams, numSamples);
+
+    // Same partials as start(), but gliding there over a few milliseconds from where they are
+    std::vector<double> frequencies;
+    std::vector<float> gains;
+
+    for (int n = 0; n < analysis.overtoneAmount; ++n)
+    {
+        frequencies.push_back(baseFrequency * (double)(n + 2));
+        gains.push_back((float)analysis.overtoneGains[(size_t)n]);
+    }
+
+    overtones.retarget(frequencies, gains, params.sampleRate, (int)juce::jmin(numSamples, (int64_t)(params.sampleRate * 0.005)));
+    return true;
+}
+
+void ImageSynthEngine::setFeatures(const FeatureChannels& newFeatures, const GenerationParameters& newParams, int64_t numSamples,
+                                   const Analysis* previous)
+{
+    features = newFeatures;
+    params = newParams;
+    analysis = previous != nullptr ? *previous : analyse(newFeatures, params, numSamples);
+
+    static const char* colourNames[] = { "red", "green", "blue" };
+    static const Waveform baseWaveforms[] = { Waveform::square, Waveform::saw, Waveform::sine };
+
+    dominantColour = colourNames[analysis.dominantChannel];
+    baseWaveform = baseWaveforms[analysis.dominantChannel];
+
+    const auto& channels = newFeatures;
+    modulator = channels[analysis.dominantChannel];
+
+    // LFOs read the channel that matches their waveform: square/red, saw/green, sine/blue
+    lfoChannels.clear();
+    for (auto waveform : analysis.lfoWaveforms)
+        lfoChannels.push_back(waveform == Waveform::square ? channels[0] : (waveform == Waveform::saw ? channels[1] : channels[2]));
+
+    // Both centre on 0.5, where the control is unchanged (see modulateFrequency and applyLfo)
+    fmDepthChannel = getSource(newFeatures, params.fmDepthSource);
+    lfoRateChannel = getSource(newFeatures, params.lfoRateSource);
+
+    lfoBaseFrequency = mapToRangeWithVariability(
+        (analysis.meanRed + analysis.meanGreen + analysis.meanBlue) / 3.0 + analysis.lfoSaturation) * params.lfoScalarFreq;
+
+    smoothingWindow = 0.0;
+    for (int j = -smoothingBehind; j <= smoothingAhead; ++j)
+        smoothingWindow += interpolate(modulator, features.size, j, numSamples);
+}
+
+int ImageSynthEngine::renderNextBlock(float* output, int maxSamples)
+{
+    if (features.isEmpty())
+        return 0;
+
+    const int numSamples = (int)juce::jmin((int64_t)maxSamples, totalLength - position);
+    if (numSamples <= 0)
+        return 0;
+
+    modulateFrequency(output, position, numSamples);
+    applyOvertones(output, numSamples);
+    applyLfo(output, position, numSamples);
+    applyLimiter(output, numSamples);
+    lowpassFilter(output, numSamples);
+    juce::FloatVectorOperations::multiply(output, params.soundLevel, numSamples);
+
+    position += numSamples;
+    return numSamples;
+}
+
+void ImageSynthEngine::modulateFrequency(float* output, int64_t start, int numSamples)
+{
+    jassert(!features.isEmpty());
+    const double sampleRate = params.sampleRate;
+
+    for (int k = 0; k < numSamples; ++k)
+    {
+        const int64_t i = start + k;
+        const double t = (double)(segmentStart + i) / sampleRate;
+
+        const double smoothed = smoothingWindow / (double)smoothingLength;
+        const double depth = fmDepthChannel != nullptr
+            ? params.modulationIntensity * 2.0 * interpolate(fmDepthChannel, features.size, i, totalLength)
+            : (double)params.modulationIntensity;
+        const double frequency = baseFrequency + (smoothed - analysis.smoothedMean) * depth;
+        const double fade = params.modulationDuration != 0.0f ? juce::jmin(t / params.modulationDuration, 1.0) : 1.0;
+        const double envelope = (1.0 - fade) * params.modulationEnvelopeIntensity;
+        const double increment = frequency / sampleRate;
+
+        output[k] = (float)(oscillate(baseWaveform, basePhase, increment) * envelope * 0.9);
+
+        basePhase += increment;
+        basePhase -= std::floor(basePhase);
+
+        smoothingWindow += interpolate(modulator, features.size, i + smoothingAhead + 1, totalLength)
+                         - interpolate(modulator, features.size, i - smoothingBehind, totalLength);
+    }
+}
+
+void ImageSynthEngine::applyOvertones(float* output, int numSamples)
+{
+    overtones.renderAdd(output, numSamples);
+}
+
+void ImageSynthEngine::applyLfo(float* output, int64_t start, int numSamples)
+{
+    jassert(!features.isEmpty());
+    if (analysis.lfoAmount <= 0)
+        return;
+
+    const double sampleRate = params.sampleRate;
+
+    for (int k = 0; k < numSamples; ++k)
+    {
+        const int64_t i = start + k;
+        const double t = (double)(segmentStart + i) / sampleRate;
+        const double rate = lfoRateChannel != nullptr ? 2.0 * interpolate(lfoRateChannel, features.size, i, totalLength) : 1.0;
+        const double increment = lfoBaseFrequency * rate * (1.0 + 0.5 * std::sin(0.1 * t)) / sampleRate;
+
+        double lfo = 1.0;
+        for (size_t l = 0; l < lfoChannels.size(); ++l)
+            lfo *= interpolate(lfoChannels[l], features.size, i, totalLength) * params.lfoScalarAmplitude
+                 * oscillate(analysis.lfoWaveforms[l], lfoPhase, increment) * params.lfoIntensity;
+
+        output[k] = (float)(output[k] * lfo);
+
+        lfoPhase += increment;
+        lfoPhase -= std::floor(lfoPhase);
+    }
+}
+
+void ImageSynthEngine::applyLimiter(float* output, int numSamples)
+{
+    juce::FloatVectorOperations::clip(output, output, -limiterThreshold, limiterThreshold, numSamples);
+}
+
+void ImageSynthEngine::lowpassFilter(float* output, int numSamples)
+{
+    // The filter sections keep their state between blocks
+    for (auto& section : lowpass)
+        for (int k = 0; k < numSamples; ++k)
+            output[k] = section->processSample(output[k]);
+}
+
+bool ImageSynthEngine::prepare(const ImageFeatures& newFeatures, const GenerationParameters& newParams)
+{
+    return prepare(newFeatures.getChannels(), newParams);
+}
+
+juce::AudioBuffer<float> ImageSynthEngine::render(const FeatureChannels& newFeatures, const GenerationParameters& newParams,
+                                                  const ProgressCallback& onProgress)
+{
+    if (!prepare(newFeatures, newParams) || totalLength > std::numeric_limits<int>::max())
+        return {};
+
+    juce::AudioBuffer<float> output(1, (int)totalLength);
+    float* out = output.getWritePointer(0);
+
+    while (!isFinished())
+    {
+        const int64_t offset = position;
+        renderNextBlock(out + offset, defaultBlockSize);
+
+        if (onProgress != nullptr && !onProgress((float)position / (float)totalLength))
+            return {};
+    }
+
+    return output;
+}
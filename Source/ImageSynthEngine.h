@@ -0,0 +1,179 @@
+/*
+  ==============================================================================
+
+    ImageSynthEngine.h
+    Created: 18 Oct 2026 6:51:43am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <juce_dsp/juce_dsp.h>
+#include "ImageFeatures.h"
+#include "Oscillators.h"
+#include <functional>
+
+// An extended image feature a synthesis control follows (see ExtendedFeature),
+// or none for the control's usual behaviour
+enum class FeatureSource { none, saturation, value, luminanceVariance, edgeDensity };
+
+// The twelve generation parameters from SliderWindow, the window order, the
+// feature mappings and the render rate. Defaults match the processor's
+// AudioParameter defaults.
+struct GenerationParameters
+{
+    int kernelSize = 25;
+    int stepSize = 10;
+    float soundLevel = 1.0f;
+    float soundDuration = 10.0f;
+    float modulationIntensity = 0.8f;
+    float modulationEnvelopeIntensity = 0.2f;
+    float modulationDuration = 6.0f;
+    float lfoScalarFreq = 0.5f;
+    float lfoScalarAmplitude = 0.6f;
+    float lfoIntensity = 0.6f;
+    float overtoneNumScalar = 1.0f;
+    float lfoAmountScalar = 1.0f;
+    TraversalOrder traversal = TraversalOrder::raster;
+    FeatureSource fmDepthSource = FeatureSource::none;      // scales modulationIntensity over time
+    FeatureSource overtoneSource = FeatureSource::none;     // sets the overtone count instead of brightness
+    FeatureSource lfoRateSource = FeatureSource::none;      // scales the LFO frequency over time
+    double sampleRate = 44100.0;
+
+    bool needsExtendedFeatures() const
+    {
+        return fmDepthSource != FeatureSource::none || overtoneSource != FeatureSource::none || lfoRateSource != FeatureSource::none;
+    }
+};
+
+//==============================================================================
+/**
+    Native port of the embedded generate_sound pipeline:
+
+        modulate_frequency -> apply_overtones -> apply_lfo -> apply_limiter -> lowpass_filter
+
+    Interpolated colour channels are evaluated per sample instead of being
+    materialised, and the pipeline runs block by block, so working memory is
+    constant whatever the duration. Oscillators
+    integrate their frequency (phase accumulators) rather than evaluating
+    sin(2*pi*f(t)*t), which avoids the chirp the Python version produces
+    when f varies over time. Each stage runs as its own pass over the block,
+    using the band-limited oscillators in Oscillators.h.
+
+    FM depth, overtone count and LFO rate can each follow one of the extended
+    features instead. They are interpolated per sample like the colour
+    channels, so a mapping costs nothing beyond reading another array. A
+    mapping whose features weren't extracted is ignored.
+*/
+class ImageSynthEngine
+{
+public:
+    enum class Waveform { sine, saw, square };
+
+    ImageSynthEngine() = default;
+
+    // Called after each block with the fraction rendered so far; return false
+    // to abandon the render, in which case render() returns an empty buffer
+    using ProgressCallback = std::function<bool(float progress)>;
+
+    // Renders a mono buffer of soundDuration seconds at params.sampleRate
+    juce::AudioBuffer<float> render(const FeatureChannels& features, const GenerationParameters& params,
+                                    const ProgressCallback& onProgress = nullptr);
+
+    // Streaming interface: prepare() once, then pull blocks until isFinished().
+    // Oscillator phases and filter state carry over between blocks, so working
+    // memory doesn't grow with the duration. features must outlive the render.
+    bool prepare(const FeatureChannels& features, const GenerationParameters& params);
+    bool prepare(const ImageFeatures& features, const GenerationParameters& params);
+    int renderNextBlock(float* output, int maxSamples);     // returns the number of samples written
+
+    // Continuous rendering across feature sets (see SequenceRenderer): the next
+    // numSamples come from newFeatures, while oscillator phases, the overtone
+    // bank, the filters and the envelope's clock carry on from the previous
+    // segment. The first call, or the first after prepare(), starts from scratch.
+    bool prepareSegment(const FeatureChannels& features, const GenerationParameters& params, int64_t numSamples);
+
+    // The stages renderNextBlock() chains, for callers that keep intermediate
+    // results (see GenerationGraph). Each stage carries its own oscillator or
+    // filter state, so after prepare() it must be fed consecutive samples from 0.
+    void modulateFrequency(float* output, int64_t start, int numSamples);     // writes the base tone
+    void applyOvertones(float* output, int numSamples);                       // adds the overtone bank
+    void applyLfo(float* output, int64_t start, int numSamples);
+    void applyLimiter(float* output, int numSamples);
+    void lowpassFilter(float* output, int numSamples);
+
+    // Everything the per-sample loop needs, derived from one pass over the
+    // interpolated channels (the means the Python code takes with np.mean)
+    struct Analysis
+    {
+        double meanRed = 0.0, meanGreen = 0.0, meanBlue = 0.0;                 // feature means
+        double interpolatedMean[3] = { 0.0, 0.0, 0.0 };                       // per channel
+        double smoothedMean = 0.0;                                              // np.mean(smooth_rgb)
+        int dominantChannel = 0;
+        int lfoAmount = 0;
+        double lfoSaturation = 0.01;
+        std::vector<Waveform> lfoWaveforms;
+        int overtoneAmount = 0;
+        std::vector<double> overtoneGains;
+    };
+
+    // prepare() with the Analysis from an earlier prepare() of the same features,
+    // duration, sample rate, LFO amount and overtone settings: skips the pass over
+    // every interpolated sample, which is most of prepare()'s cost
+    bool prepare(const FeatureChannels& features, const GenerationParameters& params, const Analysis& previous);
+    const Analysis& getAnalysis() const { return analysis; }
+
+    bool isFinished() const { return position >= totalLength; }
+    int64_t getTotalLength() const { return totalLength; }
+    int64_t getPosition() const { return position; }
+
+    // "red", "green" or "blue"; valid after prepare(), used in the output file name
+    juce::String getDominantColour() const { return dominantColour; }
+
+    static constexpr double baseFrequency = 261.6;     // C4
+    static constexpr double lowpassCutoff = 5000.0;
+    static constexpr int lowpassOrder = 5;
+    static constexpr float limiterThreshold = 0.8f;
+    static constexpr int defaultBlockSize = 4096;
+
+private:
+    Analysis analyse(const FeatureChannels& features, const GenerationParameters& params, int64_t numSamples) const;
+
+    // The part of prepare() that depends on the features, shared with prepareSegment().
+    // previous, if given, stands in for analyse().
+    void setFeatures(const FeatureChannels& newFeatures, const GenerationParameters& newParams, int64_t numSamples,
+                     const Analysis* previous = nullptr);
+    bool start(const FeatureChannels& newFeatures, const GenerationParameters& newParams, int64_t numSamples,
+               const Analysis* previous = nullptr);
+
+    // The extended channel source reads, or null if it's none or wasn't extracted
+    static const float* getSource(const FeatureChannels& features, FeatureSource source);
+
+    static float interpolate(const float* values, int64_t length, int64_t index, int64_t numSamples);
+    static float oscillate(Waveform waveform, double phase, double increment);
+    static int roundHalfEven(double value);
+
+    juce::String dominantColour{ "red" };
+
+    // Render state, carried from one block to the next
+    FeatureChannels features;
+    GenerationParameters params;
+    Analysis analysis;
+    Waveform baseWaveform = Waveform::square;
+    const float* modulator = nullptr;
+    std::vector<const float*> lfoChannels;
+    const float* fmDepthChannel = nullptr;      // from params.fmDepthSource; null when unmapped
+    const float* lfoRateChannel = nullptr;
+    SineBank overtones;
+    std::vector<std::unique_ptr<juce::dsp::IIR::Filter<float>>> lowpass;
+    double lfoBaseFrequency = 0.0;
+    double smoothingWindow = 0.0;
+    double basePhase = 0.0, lfoPhase = 0.0;
+    int64_t position = 0, totalLength = 0;
+    int64_t segmentStart = 0;           // samples rendered by earlier segments, for the envelope and LFO clocks
+    bool segmentStarted = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ImageSynthEngine)
+};
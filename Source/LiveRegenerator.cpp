@@ -0,0 +1,100 @@
+/*
+  ==============================================================================
+
+    LiveRegenerator.cpp
+    Created: 18 Oct 2026 7:18:44am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#include "LiveRegenerator.h"
+#include "PluginProcessor.h"
+
+LiveRegenerator::LiveRegenerator(ImagineAudioProcessor& p, const juce::Array<juce::AudioProcessorParameter*>& params)
+    : processor(p), parameters(params)
+{
+    for (auto* parameter : parameters)
+        parameter->addListener(this);
+}
+
+LiveRegenerator::~LiveRegenerator()
+{
+    stopTimer();
+
+    for (auto* parameter : parameters)
+        parameter->removeListener(this);
+}
+
+void LiveRegenerator::setEnabled(bool shouldBeEnabled)
+{
+    enabled = shouldBeEnabled;
+
+    if (!enabled)
+    {
+        stopTimer();
+        return;
+    }
+
+    // Render what the parameters say now, without waiting for a change
+    lastChange = 0;
+    changed = true;
+    startTimer(10);
+}
+
+void LiveRegenerator::setImage(const juce::File& imageFile)
+{
+    image = imageFile;
+
+    lastChange = 0;
+    changed = true;
+}
+
+void LiveRegenerator::parameterValueChanged(int, float)
+{
+    lastChange = juce::Time::getMillisecondCounter();
+    changed = true;
+}
+
+void LiveRegenerator::timerCallback()
+{
+    if (!changed || juce::Time::getMillisecondCounter() - lastChange < (juce::uint32)debounceMs)
+        return;
+
+    changed = false;
+    regenerate();
+}
+
+void LiveRegenerator::regenerate()
+{
+    if (!enabled || !image.existsAsFile())
+        return;
+
+    submit(processor.getGenerationParameters(), true);
+}
+
+void LiveRegenerator::submit(const GenerationParameters& params, bool isPreview)
+{
+    GenerationRequest request;
+    request.imagePath = image.getFullPathName().toStdString();
+    request.params = params;
+    request.previewSeconds = isPreview ? previewSeconds : 0.0;
+
+    // Superseded renders never call back, so a stale result can't replace a newer one.
+    // Only other live renders are superseded; a Generate in progress carries on.
+    processor.generationQueue->submitLive(std::move(request), nullptr,
+        [this, params, isPreview](const GenerationResult& result)
+        {
+            if (result.sound != nullptr)
+            {
+                processor.setGeneratedSound(result.sound, result.sampleRate);
+
+                if (onSoundChanged != nullptr)
+                    onSoundChanged(result, isPreview);
+            }
+
+            // Refine to the full render unless the parameters have moved on already
+            if (isPreview && enabled && !changed)
+                submit(params, false);
+        });
+}
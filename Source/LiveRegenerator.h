@@ -0,0 +1,69 @@
+/*
+  ==============================================================================
+
+    LiveRegenerator.h
+    Created: 18 Oct 2026 7:18:44am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "GenerationQueue.h"
+#include <atomic>
+#include <functional>
+
+class ImagineAudioProcessor;
+
+//==============================================================================
+/**
+    Live mode: regenerates the sound whenever a generation parameter changes,
+    whether from the sliders or host automation.
+
+    Once the parameters have been still for debounceMs, a preview (the first
+    previewSeconds, from coarser features) is rendered and swapped into the
+    sampler, which takes well under 100 ms. The full render follows in the
+    background and replaces it. A further change cancels the live render in
+    progress, but never a Generate or preload; those finish first.
+
+    Only the native generator is used; the Python one is far too slow.
+*/
+class LiveRegenerator : private juce::AudioProcessorParameter::Listener,
+                        private juce::Timer
+{
+public:
+    LiveRegenerator(ImagineAudioProcessor& processor, const juce::Array<juce::AudioProcessorParameter*>& parameters);
+    ~LiveRegenerator() override;
+
+    void setEnabled(bool shouldBeEnabled);
+    bool isEnabled() const { return enabled; }
+
+    // The image renders start from; changing it regenerates straight away
+    void setImage(const juce::File& imageFile);
+
+    // Called on the message thread each time the sampler gets a new sound
+    std::function<void(const GenerationResult& result, bool isPreview)> onSoundChanged;
+
+    static constexpr int debounceMs = 50;
+    static constexpr double previewSeconds = 2.0;
+
+private:
+    // May be called on the audio thread, so it only records the time
+    void parameterValueChanged(int parameterIndex, float newValue) override;
+    void parameterGestureChanged(int, bool) override {}
+
+    void timerCallback() override;
+    void regenerate();
+    void submit(const GenerationParameters& params, bool isPreview);
+
+    ImagineAudioProcessor& processor;
+    juce::Array<juce::AudioProcessorParameter*> parameters;
+    juce::File image;
+    bool enabled = false;
+
+    std::atomic<bool> changed{ false };
+    std::atomic<juce::uint32> lastChange{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LiveRegenerator)
+};
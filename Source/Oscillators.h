@@ -0,0 +1,229 @@
+/*
+  ==============================================================================
+
+    Oscillators.h
+    Created: 18 Oct 2026 7:00:50am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <juce_dsp/juce_dsp.h>
+#include <vector>
+
+// Shared oscillator building blocks for the generator and for voice code.
+// Phases are in cycles, [0, 1); increments are frequency / sampleRate.
+namespace oscillators
+{
+    // sin(2*pi*x) for x in [-0.25, 0.25]; odd 9th order Taylor, error < 4e-6.
+    // Written with (vector * scalar) and (vector + scalar) only, so it works
+    // for float and juce::dsp::SIMDRegister<float> alike.
+    template <typename T>
+    inline T sineQuarter(T x)
+    {
+        const T y = x * 6.28318530718f;
+        const T y2 = y * y;
+        return ((((y2 * 2.7557319e-6f - 1.9841270e-4f) * y2 + 8.3333333e-3f) * y2 - 1.6666667e-1f) * y2 + 1.0f) * y;
+    }
+
+    // sin(2*pi*phase) for phase in [0, 1)
+    inline float fastSine(float phase)
+    {
+        // sin(2*pi*p) = -sin(2*pi*(p - 0.5)); fold [-0.5, 0.5) into [-0.25, 0.25]
+        float x = phase - 0.5f;
+        x = juce::jmin(x, 0.5f - x);
+        x = juce::jmax(x, -0.5f - x);
+        return -sineQuarter(x);
+    }
+
+    inline juce::dsp::SIMDRegister<float> fastSine(juce::dsp::SIMDRegister<float> phase)
+    {
+        using Vec = juce::dsp::SIMDRegister<float>;
+
+        Vec x = phase - 0.5f;
+        x = Vec::min(x, Vec::expand(0.5f) - x);
+        x = Vec::max(x, Vec::expand(-0.5f) - x);
+        return sineQuarter(x) * -1.0f;
+    }
+
+    // Two-sample polynomial band-limited step residual around a wrap at phase 0
+    inline double polyBlep(double phase, double increment)
+    {
+        if (phase < increment)
+        {
+            const double t = phase / increment;
+            return t + t - t * t - 1.0;
+        }
+
+        if (phase > 1.0 - increment)
+        {
+            const double t = (phase - 1.0) / increment;
+            return t * t + t + t + 1.0;
+        }
+
+        return 0.0;
+    }
+
+    // Rising saw, -1 at phase 0 (scipy.signal.sawtooth)
+    inline float saw(double phase, double increment)
+    {
+        return (float)(2.0 * phase - 1.0 - polyBlep(phase, increment));
+    }
+
+    // +1 for the first half of the cycle (scipy.signal.square)
+    inline float square(double phase, double increment)
+    {
+        double falling = phase + 0.5;
+        falling -= std::floor(falling);
+
+        const double naive = phase < 0.5 ? 1.0 : -1.0;
+        return (float)(naive + polyBlep(phase, increment) - polyBlep(falling, increment));
+    }
+}
+
+//==============================================================================
+/**
+    A bank of fixed-frequency sine partials in structure-of-arrays layout.
+    Each SIMDRegister lane is one partial, so a whole register's worth of
+    partials advances and evaluates in a handful of vector instructions.
+*/
+class SineBank
+{
+public:
+    void clear()
+    {
+        phases.clear();
+        increments.clear();
+        gains.clear();
+        targetGains.clear();
+        gainSteps.clear();
+        numPartials = 0;
+        wantedPartials = 0;
+        rampRemaining = 0;
+    }
+
+    // Partials start at phase 0, i.e. sin(0)
+    void addPartial(double frequency, float gain, double sampleRate)
+    {
+        const size_t lane = (size_t)numPartials % Vec::size();
+
+        if (lane == 0)
+        {
+            phases.push_back(Vec::expand(0.0f));
+            increments.push_back(Vec::expand(0.0f));
+            gains.push_back(Vec::expand(0.0f));     // unused lanes stay silent
+        }
+
+        increments.back().set(lane, (float)(frequency / sampleRate));
+        gains.back().set(lane, gain);
+        ++numPartials;
+    }
+
+    int getNumPartials() const { return numPartials; }
+
+    // Glides to a new set of partials over rampSamples without resetting any phase,
+    // so the bank can change mid-sound without a click. Partials that are no longer
+    // wanted fade to silence and are dropped once the ramp ends; new ones fade in
+    // from phase 0.
+    void retarget(const std::vector<double>& frequencies, const std::vector<float>& newGains, double sampleRate, int rampSamples)
+    {
+        const int wanted = (int)juce::jmin(frequencies.size(), newGains.size());
+        wantedPartials = wanted;
+
+        while (numPartials < wanted)
+            addPartial(frequencies[(size_t)numPartials], 0.0f, sampleRate);
+
+        targetGains.assign(gains.size(), Vec::expand(0.0f));
+        gainSteps.assign(gains.size(), Vec::expand(0.0f));
+        rampRemaining = juce::jmax(1, rampSamples);
+
+        for (int n = 0; n < numPartials; ++n)
+        {
+            const size_t group = (size_t)n / Vec::size();
+            const size_t lane = (size_t)n % Vec::size();
+
+            if (n < wanted)
+            {
+                increments[group].set(lane, (float)(frequencies[(size_t)n] / sampleRate));
+                targetGains[group].set(lane, newGains[(size_t)n]);
+            }
+
+            gainSteps[group].set(lane, (targetGains[group].get(lane) - gains[group].get(lane)) / (float)rampRemaining);
+        }
+    }
+
+    // Adds the sum of all partials to output
+    void renderAdd(float* output, int numSamples)
+    {
+        if (numPartials == 0)
+            return;
+
+        const Vec one = Vec::expand(1.0f);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            Vec sum = Vec::expand(0.0f);
+
+            // Re-read each sample: the bank shrinks when a ramp ends
+            for (size_t g = 0; g < phases.size(); ++g)
+            {
+                sum += oscillators::fastSine(phases[g]) * gains[g];
+
+                Vec phase = phases[g] + increments[g];
+                phases[g] = phase - (one & Vec::greaterThanOrEqual(phase, one));
+            }
+
+            output[i] += sum.sum();
+
+            if (rampRemaining > 0)
+                stepGains();
+        }
+    }
+
+private:
+    using Vec = juce::dsp::SIMDRegister<float>;
+
+    void stepGains()
+    {
+        if (--rampRemaining == 0)
+        {
+            gains = targetGains;
+            dropSilentPartials();
+            return;
+        }
+
+        for (size_t g = 0; g < gains.size(); ++g)
+            gains[g] += gainSteps[g];
+    }
+
+    // The partials past the last retarget's count have faded out, so the
+    // render loop stops paying for them. Freed lanes in the last group are
+    // reset, so a partial added there later starts at phase 0.
+    void dropSilentPartials()
+    {
+        numPartials = juce::jmin(numPartials, wantedPartials);
+
+        const size_t numGroups = ((size_t)numPartials + Vec::size() - 1) / Vec::size();
+        phases.resize(numGroups);
+        increments.resize(numGroups);
+        gains.resize(numGroups);
+
+        for (size_t lane = (size_t)numPartials % Vec::size(); lane != 0 && lane < Vec::size(); ++lane)
+        {
+            phases.back().set(lane, 0.0f);
+            increments.back().set(lane, 0.0f);
+            gains.back().set(lane, 0.0f);
+        }
+
+        targetGains.clear();
+        gainSteps.clear();
+    }
+
+    std::vector<Vec> phases, increments, gains;
+    std::vector<Vec> targetGains, gainSteps;    // only while a retarget ramp runs
+    int numPartials = 0;
+    int wantedPartials = 0;                     // as of the last retarget
+    int rampRemaining = 0;
+};
@@ -0,0 +1,57 @@
+/*
+  ==============================================================================
+
+    ParallelFor.h
+    Created: 18 Oct 2026 6:47:11am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+// Splits [begin, end) into contiguous ranges and runs fn(rangeBegin, rangeEnd)
+// on one thread per core. Ranges smaller than minGrain are not split further,
+// so small jobs run inline on the calling thread.
+template <typename Function>
+void parallelFor(int begin, int end, int minGrain, Function&& fn)
+{
+    const int total = end - begin;
+    if (total <= 0)
+        return;
+
+    const int maxThreads = juce::jmax(1, juce::SystemStats::getNumCpus());
+    const int numThreads = juce::jlimit(1, maxThreads, total / juce::jmax(1, minGrain));
+
+    if (numThreads == 1)
+    {
+        fn(begin, end);
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve((size_t)numThreads - 1);
+
+    const int chunk = total / numThreads;
+    const int remainder = total % numThreads;
+    int rangeStart = begin;
+
+    for (int t = 0; t < numThreads; ++t)
+    {
+        const int rangeEnd = rangeStart + chunk + (t < remainder ? 1 : 0);
+
+        if (t == numThreads - 1)
+            fn(rangeStart, rangeEnd);   // the calling thread takes the last range
+        else
+            workers.emplace_back([&fn, rangeStart, rangeEnd] { fn(rangeStart, rangeEnd); });
+
+        rangeStart = rangeEnd;
+    }
+
+    for (auto& worker : workers)
+        worker.join();
+}
@@ -0,0 +1,365 @@
+/*
+  ==============================================================================
+
+    ParameterSweep.cpp
+    Created: 18 Oct 2026 7:21:28am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#include "ParameterSweep.h"
+#include "BatchConverter.h"
+#include "DaemonProtocol.h"
+#include "GenerationGraph.h"
+#include "ParallelFor.h"
+#include <atomic>
+#include <limits>
+#include <mutex>
+
+namespace
+{
+    const char* const parameterNames[ParameterSweep::numParameters] = {
+        "kernel_size", "step_size", "sound_level", "sound_duration",
+        "modulation_intensity", "modulation_envelope_intensity", "modulation_duration",
+        "lfo_scalar_freq", "lfo_scalar_amplitude", "lfo_intensity", "overtone_num_scalar", "lfo_amount_scalar"
+    };
+
+    // A tone buffer shared by every variant whose key matches, rendered by
+    // whichever needs it first and freed when the last one is done with it
+    struct SharedStage
+    {
+        const GenerationParameters* params = nullptr;      // any variant with this key
+        std::once_flag rendered;
+        std::vector<float> samples;                         // empty until rendered, or if it failed
+        std::atomic<int> users{ 0 };                        // variants still to use it
+    };
+
+    // ImageSynthEngine::analyse() for every variant whose key matches
+    struct SharedAnalysis
+    {
+        const GenerationParameters* params = nullptr;
+        std::once_flag analysed;
+        ImageSynthEngine::Analysis analysis;
+        bool valid = false;
+    };
+
+    using StageKey = std::vector<double>;
+
+    // What analyse() reads, as in GenerationGraph::render
+    StageKey analysisKey(const GenerationParameters& p)
+    {
+        return { (double)p.kernelSize, (double)p.stepSize, (double)p.soundDuration, p.sampleRate,
+                 (double)p.lfoAmountScalar, (double)p.overtoneNumScalar, (double)p.overtoneSource };
+    }
+
+    // The same inputs GenerationGraph keys its stages on
+    StageKey baseToneKey(const GenerationParameters& p)
+    {
+        return { (double)p.kernelSize, (double)p.stepSize, (double)p.soundDuration, p.sampleRate,
+                 (double)p.modulationIntensity, (double)p.modulationEnvelopeIntensity, (double)p.modulationDuration,
+                 (double)p.fmDepthSource };
+    }
+
+    StageKey overtoneKey(const GenerationParameters& p)
+    {
+        return { (double)p.kernelSize, (double)p.stepSize, (double)p.soundDuration, p.sampleRate,
+                 (double)p.overtoneNumScalar, (double)p.overtoneSource };
+    }
+}
+
+juce::String ParameterSweep::getName(Parameter parameter)
+{
+    return parameterNames[(int)parameter];
+}
+
+bool ParameterSweep::fromName(const juce::String& name, Parameter& parameter)
+{
+    const auto normalised = name.trim().replaceCharacter('-', '_');
+
+    for (int i = 0; i < numParameters; ++i)
+    {
+        if (normalised.equalsIgnoreCase(parameterNames[i]))
+        {
+            parameter = (Parameter)i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ParameterSweep::set(GenerationParameters& params, Parameter parameter, double value)
+{
+    switch (parameter)
+    {
+        case Parameter::kernelSize:                     params.kernelSize = (int)value; break;
+        case Parameter::stepSize:                       params.stepSize = (int)value; break;
+        case Parameter::soundLevel:                     params.soundLevel = (float)value; break;
+        case Parameter::soundDuration:                  params.soundDuration = (float)value; break;
+        case Parameter::modulationIntensity:            params.modulationIntensity = (float)value; break;
+        case Parameter::modulationEnvelopeIntensity:    params.modulationEnvelopeIntensity = (float)value; break;
+        case Parameter::modulationDuration:             params.modulationDuration = (float)value; break;
+        case Parameter::lfoScalarFreq:                  params.lfoScalarFreq = (float)value; break;
+        case Parameter::lfoScalarAmplitude:             params.lfoScalarAmplitude = (float)value; break;
+        case Parameter::lfoIntensity:                   params.lfoIntensity = (float)value; break;
+        case Parameter::overtoneNumScalar:              params.overtoneNumScalar = (float)value; break;
+        case Parameter::lfoAmountScalar:                params.lfoAmountScalar = (float)value; break;
+    }
+}
+
+double ParameterSweep::get(const GenerationParameters& params, Parameter parameter)
+{
+    switch (parameter)
+    {
+        case Parameter::kernelSize:                     return params.kernelSize;
+        case Parameter::stepSize:                       return params.stepSize;
+        case Parameter::soundLevel:                     return params.soundLevel;
+        case Parameter::soundDuration:                  return params.soundDuration;
+        case Parameter::modulationIntensity:            return params.modulationIntensity;
+        case Parameter::modulationEnvelopeIntensity:    return params.modulationEnvelopeIntensity;
+        case Parameter::modulationDuration:             return params.modulationDuration;
+        case Parameter::lfoScalarFreq:                  return params.lfoScalarFreq;
+        case Parameter::lfoScalarAmplitude:             return params.lfoScalarAmplitude;
+        case Parameter::lfoIntensity:                   return params.lfoIntensity;
+        case Parameter::overtoneNumScalar:              return params.overtoneNumScalar;
+        case Parameter::lfoAmountScalar:                return params.lfoAmountScalar;
+    }
+
+    return 0.0;
+}
+
+std::vector<GenerationParameters> ParameterSweep::expand(const GenerationParameters& base, const std::vector<Axis>& grid)
+{
+    std::vector<GenerationParameters> variants{ base };
+
+    for (const auto& axis : grid)
+    {
+        if (axis.values.empty())
+            continue;
+
+        std::vector<GenerationParameters> next;
+        next.reserve(variants.size() * axis.values.size());
+
+        for (const auto& variant : variants)
+        {
+            for (double value : axis.values)
+            {
+                next.push_back(variant);
+                set(next.back(), axis.parameter, value);
+            }
+        }
+
+        variants = std::move(next);
+    }
+
+    return variants;
+}
+
+std::vector<ParameterSweep::Variant> ParameterSweep::render(const juce::File& imageFile, const std::vector<GenerationParameters>& variants,
+                                                            const std::string& outputPath, const ProgressCallback& onProgress)
+{
+    if (variants.empty())
+        return {};
+
+    // Decoded once into a pyramid (or read in strips if it's too large); block
+    // means once per kernel and step size, from the feature cache when possible
+    GenerationGraph graph;
+    std::map<std::pair<int, int>, ImageFeatures> features;
+
+    for (const auto& params : variants)
+    {
+        const std::pair<int, int> key{ params.kernelSize, params.stepSize };
+        if (features.count(key) > 0)
+            continue;
+
+        // The graph's memo only holds one kernel and step at a time, so each set is copied out.
+        // The window order and feature mappings aren't sweep axes, so they're the same for every variant.
+        const FeatureChannels* channels = graph.getFeatures(imageFile, params.kernelSize, params.stepSize, params.traversal,
+                                                            params.needsExtendedFeatures());
+        if (channels == nullptr)
+            return {};
+
+        auto& copy = features[key];
+        for (auto [channel, destination] : { std::make_pair(0, &copy.red), std::make_pair(1, &copy.green), std::make_pair(2, &copy.blue) })
+            destination->assign((*channels)[channel], (*channels)[channel] + channels->size);
+
+        if (channels->hasExtended())
+            for (size_t i = 0; i < copy.extended.size(); ++i)
+                copy.extended[i].assign(channels->extended[i], channels->extended[i] + channels->size);
+    }
+
+    const juce::String name = imageFile.getFileNameWithoutExtension();
+    const juce::File folder = getFolder(imageFile, outputPath);
+
+    if (folder.createDirectory().failed())
+        return {};
+
+    std::map<StageKey, SharedStage> baseTones, overtones;
+    std::map<StageKey, SharedAnalysis> analyses;
+
+    for (const auto& params : variants)
+    {
+        for (auto* stage : { &baseTones[baseToneKey(params)], &overtones[overtoneKey(params)] })
+        {
+            stage->params = &params;
+            ++stage->users;
+        }
+
+        analyses[analysisKey(params)].params = &params;
+    }
+
+    std::atomic<bool> stopped{ false };
+    std::atomic<int> tasksDone{ 0 };
+    std::mutex progressLock;
+    const auto totalTasks = (float)(baseTones.size() + overtones.size() + variants.size());
+
+    auto taskFinished = [&]
+    {
+        const int done = ++tasksDone;
+
+        std::lock_guard<std::mutex> sl(progressLock);
+        if (onProgress != nullptr && !stopped && !onProgress((float)done / totalTasks))
+            stopped = true;
+    };
+
+    // Prepares an engine for params, analysing once per analysis key
+    auto prepare = [&](const GenerationParameters& params, ImageSynthEngine& engine)
+    {
+        const auto& source = features.at({ params.kernelSize, params.stepSize });
+        auto& shared = analyses.at(analysisKey(params));
+
+        std::call_once(shared.analysed, [&]
+            {
+                ImageSynthEngine analyser;
+                shared.valid = analyser.prepare(source, *shared.params);
+
+                if (shared.valid)
+                    shared.analysis = analyser.getAnalysis();
+            });
+
+        return shared.valid && engine.prepare(source, params, shared.analysis)
+            && engine.getTotalLength() <= std::numeric_limits<int>::max();
+    };
+
+    // Feeds process consecutive blocks from 0, after prepare()
+    auto runEngine = [&](ImageSynthEngine& engine, const std::function<void(float*, int64_t, int)>& process, float* samples)
+    {
+        const int64_t length = engine.getTotalLength();
+
+        for (int64_t start = 0; start < length && !stopped; start += ImageSynthEngine::defaultBlockSize)
+            process(samples + start, start, (int)juce::jmin((int64_t)ImageSynthEngine::defaultBlockSize, length - start));
+
+        return !stopped;
+    };
+
+    // The stage's samples, rendered by the first variant to ask
+    auto getStage = [&](SharedStage& stage, const std::function<void(ImageSynthEngine&, float*, int64_t, int)>& process)
+        -> const std::vector<float>&
+    {
+        std::call_once(stage.rendered, [&]
+            {
+                ImageSynthEngine engine;
+
+                if (prepare(*stage.params, engine))
+                {
+                    stage.samples.resize((size_t)engine.getTotalLength());
+
+                    if (!runEngine(engine, [&](float* out, int64_t start, int n) { process(engine, out, start, n); }, stage.samples.data()))
+                        stage.samples = {};
+                }
+
+                taskFinished();
+            });
+
+        return stage.samples;
+    };
+
+    auto release = [](SharedStage& stage)
+    {
+        if (--stage.users == 0)
+            std::vector<float>().swap(stage.samples);
+    };
+
+    const int digits = juce::jmax(2, juce::String((int)variants.size()).length());
+    std::vector<Variant> result(variants.size());
+
+    parallelFor(0, (int)variants.size(), 1, [&](int begin, int end)
+        {
+            for (int i = begin; i < end && !stopped; ++i)
+            {
+                const auto& params = variants[(size_t)i];
+                auto& variant = result[(size_t)i];
+                variant.params = params;
+
+                auto& baseStage = baseTones.at(baseToneKey(params));
+                auto& overtoneStage = overtones.at(overtoneKey(params));
+
+                const auto& base = getStage(baseStage, [](ImageSynthEngine& engine, float* out, int64_t start, int n)
+                    {
+                        engine.modulateFrequency(out, start, n);
+                    });
+
+                const auto& tones = getStage(overtoneStage, [](ImageSynthEngine& engine, float* out, int64_t, int n)
+                    {
+                        juce::FloatVectorOperations::clear(out, n);
+                        engine.applyOvertones(out, n);
+                    });
+
+                // The tail renders into the buffer that is written, then dropped
+                ImageSynthEngine engine;
+
+                if (!base.empty() && !tones.empty() && prepare(params, engine) && (size_t)engine.getTotalLength() == base.size())
+                {
+                    juce::AudioBuffer<float> sound(1, (int)base.size());
+
+                    auto process = [&](float* out, int64_t start, int n)
+                    {
+                        juce::FloatVectorOperations::add(out, base.data() + start, tones.data() + start, n);
+                        engine.applyLfo(out, start, n);
+                        engine.applyLimiter(out, n);
+                        engine.lowpassFilter(out, n);
+                        juce::FloatVectorOperations::multiply(out, params.soundLevel, n);
+                    };
+
+                    const juce::File file = folder.getChildFile(name + "_" + juce::String(i + 1).paddedLeft('0', digits) + ".wav");
+
+                    if (runEngine(engine, process, sound.getWritePointer(0))
+                        && BatchConverter::writeWavFile(sound, file, params.sampleRate))
+                    {
+                        variant.file = file;
+                        variant.dominantColour = engine.getDominantColour();
+                    }
+                }
+
+                release(baseStage);
+                release(overtoneStage);
+                taskFinished();
+            }
+        });
+
+    if (stopped)
+        return {};
+
+    juce::Array<juce::var> listing;
+
+    for (const auto& variant : result)
+    {
+        if (variant.file == juce::File())
+            continue;
+
+        auto* entry = new juce::DynamicObject();
+        entry->setProperty("file", variant.file.getFileName());
+        entry->setProperty("colour", variant.dominantColour);
+        entry->setProperty("params", DaemonProtocol::toVar(variant.params));
+        listing.add(juce::var(entry));
+    }
+
+    folder.getChildFile("sweep.json").replaceWithText(juce::JSON::toString(juce::var(listing)));
+    return result;
+}
+
+juce::File ParameterSweep::getFolder(const juce::File& imageFile, const std::string& outputPath)
+{
+    return juce::File(outputPath + imageFile.getFileNameWithoutExtension().toStdString() + "_sweep");
+}
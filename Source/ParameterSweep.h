@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    ParameterSweep.h
+    Created: 18 Oct 2026 7:21:28am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "ImageFeatures.h"
+#include "ImageSynthEngine.h"
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+//==============================================================================
+/**
+    Renders many variations of one image, one per point of a parameter grid.
+
+    Work is shared the same way GenerationGraph shares it between renders:
+    the image is decoded once, block means are computed once per kernel and
+    step size, the engine's analysis pass once per set of the inputs it reads,
+    and the base tone and overtone buffers once per distinct set of the
+    parameters they depend on. Only the LFO, limiter, filter and level run
+    per variant. Variants fan out across the cores, so sweeping the LFO or
+    the level costs little more than a single render.
+
+    Shared buffers are rendered the first time a variant needs them and
+    released once the last variant that uses them is done. Each variant is
+    written to its WAV as soon as it's rendered, so memory holds the buffers
+    in use rather than the whole sweep.
+*/
+class ParameterSweep
+{
+public:
+    enum class Parameter
+    {
+        kernelSize, stepSize, soundLevel, soundDuration,
+        modulationIntensity, modulationEnvelopeIntensity, modulationDuration,
+        lfoScalarFreq, lfoScalarAmplitude, lfoIntensity, overtoneNumScalar, lfoAmountScalar
+    };
+
+    struct Axis
+    {
+        Parameter parameter;
+        std::vector<double> values;
+    };
+
+    struct Variant
+    {
+        GenerationParameters params;
+        juce::File file;                // empty if this one failed
+        juce::String dominantColour;
+    };
+
+    // Called from worker threads, one call at a time; return false to stop
+    using ProgressCallback = std::function<bool(float progress)>;
+
+    static constexpr int numParameters = 12;
+
+    // The generator's argument name, e.g. "lfo_intensity"
+    static juce::String getName(Parameter parameter);
+    static bool fromName(const juce::String& name, Parameter& parameter);     // also accepts "lfo-intensity"
+
+    static void set(GenerationParameters& params, Parameter parameter, double value);
+    static double get(const GenerationParameters& params, Parameter parameter);
+
+    // Every combination of the axes' values applied to base, the last axis varying fastest
+    static std::vector<GenerationParameters> expand(const GenerationParameters& base, const std::vector<Axis>& grid);
+
+    // Renders the variants and writes them to {outputPath}{image}_sweep/{image}_01.wav
+    // and so on, numbered in the order given, plus sweep.json listing each file
+    // with its parameters. Returns the variants in that order; empty if the image
+    // can't be read or the sweep was stopped (files already written stay).
+    static std::vector<Variant> render(const juce::File& imageFile, const std::vector<GenerationParameters>& variants,
+                                       const std::string& outputPath, const ProgressCallback& onProgress = nullptr);
+
+    // {outputPath}{image}_sweep
+    static juce::File getFolder(const juce::File& imageFile, const std::string& outputPath);
+};
@@ -9,6 +9,7 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 #include "HelpWindow.h"
+#include "ImageLoader.h"
 
 
 //==============================================================================
@@ -381,6 +382,32 @@ ImagineAudioProcessorEditor::ImagineAudioProcessorEditor(ImagineAudioProcessor&
     loadButton.addListener(this);
     addAndMakeVisible(&loadButton);
 
+    watchButton.setButtonText(audioProcessor.watchFolder->isWatching() ? "Stop Watching" : "Watch Folder");
+    watchButton.addListener(this);
+    addAndMakeVisible(&watchButton);
+
+    liveButton.setButtonText("Live");
+    liveButton.setTooltip("Regenerate automatically when a generation parameter changes");
+    liveButton.setToggleState(audioProcessor.liveRegenerator->isEnabled(), juce::dontSendNotification);
+    liveButton.addListener(this);
+    addAndMakeVisible(&liveButton);
+
+    sweepButton.setButtonText("Sweep");
+    sweepButton.setTooltip("Render one file per value of a parameter");
+    sweepButton.addListener(this);
+    addAndMakeVisible(&sweepButton);
+
+    juce::Component::SafePointer<ImagineAudioProcessorEditor> safeThis(this);
+    audioProcessor.liveRegenerator->onSoundChanged = [safeThis](const GenerationResult&, bool)
+    {
+        if (safeThis == nullptr || safeThis->audioProcessor.mainbuffer == nullptr)
+            return;
+
+        safeThis->startPosition = 0;
+        safeThis->endPosition = safeThis->audioProcessor.mainbuffer->getNumSamples();
+        safeThis->showMainBufferThumbnail();
+    };
+
     toggleWindow.setButtonText("Toggle Parameter Window");
     toggleWindow.addListener(this);
     addAndMakeVisible(&toggleWindow);
@@ -405,7 +432,11 @@ ImagineAudioProcessorEditor::ImagineAudioProcessorEditor(ImagineAudioProcessor&
     windowComponent->getKernelSlider().onValueChange = [this] {audioProcessor.kernel->setValueNotifyingHost(windowComponent->getKernelSlider().getValue() / 50.0f); };
     windowComponent->getStepSlider().onValueChange = [this] {audioProcessor.stepSize->setValueNotifyingHost(windowComponent->getStepSlider().getValue() / 50.0f); };
     windowComponent->getSoundLevelSlider().onValueChange = [this] {audioProcessor.level->setValueNotifyingHost(windowComponent->getSoundLevelSlider().getValue() / 10.0f); };
-    windowComponent->getSoundDurationSlider().onValueChange = [this] {audioProcessor.duration->setValueNotifyingHost(windowComponent->getSoundDurationSlider().getValue() / 30.0f); };
+    windowComponent->getSoundDurationSlider().onValueChange = [this]
+    {
+        audioProcessor.duration->setValueNotifyingHost(windowComponent->getSoundDurationSlider().getValue() / 300.0f);
+        applyAutoResolution();      // longer sounds can use more features
+    };
     windowComponent->getModulationIntensitySlider().onValueChange = [this] {audioProcessor.modulationIntensity->setValueNotifyingHost(windowComponent->getModulationIntensitySlider().getValue()); };
     windowComponent->getModulationEnvelopeIntensitySlider().onValueChange = [this] {audioProcessor.modulationEnvelopeIntensity->setValueNotifyingHost(windowComponent->getModulationEnvelopeIntensitySlider().getValue()); };
     windowComponent->getModulationDurationSlider().onValueChange = [this] {audioProcessor.modulationDuration->setValueNotifyingHost((windowComponent->getModulationDurationSlider().getValue() + 20.0f) / 40.0f); };
@@ -415,8 +446,38 @@ ImagineAudioProcessorEditor::ImagineAudioProcessorEditor(ImagineAudioProcessor&
     windowComponent->getOvertoneNumScalarSlider().onValueChange = [this] {audioProcessor.overtoneNumScalar->setValueNotifyingHost(windowComponent->getOvertoneNumScalarSlider().getValue() / 4.0f); };
     windowComponent->getLfoAmountScalarSlider().onValueChange = [this] {audioProcessor.lfoAmountScalar->setValueNotifyingHost(windowComponent->getLfoAmountScalarSlider().getValue() / 4.0f); };
 
+    windowComponent->getTraversalBox().setSelectedId(audioProcessor.traversal->getIndex() + 1, juce::dontSendNotification);
+    windowComponent->getTraversalBox().onChange = [this] { *audioProcessor.traversal = windowComponent->getTraversalBox().getSelectedId() - 1; };
+
+    // The Python generator always reads the image row by row
+    if (!audioProcessor.useNativeGenerator)
+    {
+        windowComponent->getTraversalBox().setEnabled(false);
+        windowComponent->getTraversalBox().setTooltip("Only the native generator can read the image in another order");
+    }
+
+    windowComponent->getFmDepthSourceBox().setSelectedId(audioProcessor.fmDepthSource->getIndex() + 1, juce::dontSendNotification);
+    windowComponent->getFmDepthSourceBox().onChange = [this] { *audioProcessor.fmDepthSource = windowComponent->getFmDepthSourceBox().getSelectedId() - 1; };
+    windowComponent->getOvertoneSourceBox().setSelectedId(audioProcessor.overtoneSource->getIndex() + 1, juce::dontSendNotification);
+    windowComponent->getOvertoneSourceBox().onChange = [this] { *audioProcessor.overtoneSource = windowComponent->getOvertoneSourceBox().getSelectedId() - 1; };
+    windowComponent->getLfoRateSourceBox().setSelectedId(audioProcessor.lfoRateSource->getIndex() + 1, juce::dontSendNotification);
+    windowComponent->getLfoRateSourceBox().onChange = [this] { *audioProcessor.lfoRateSource = windowComponent->getLfoRateSourceBox().getSelectedId() - 1; };
+
+    windowComponent->setAutoResolution(audioProcessor.autoResolution);
+    windowComponent->getAutoResolutionButton().onClick = [this]
+    {
+        audioProcessor.autoResolution = windowComponent->getAutoResolutionButton().getToggleState();
+        windowComponent->setAutoResolution(audioProcessor.autoResolution);
+        applyAutoResolution();
+    };
+
     juce::File generatedFile(audioProcessor.outputpath);
-    if (generatedFile.existsAsFile())
+    if (audioProcessor.mainbuffer != nullptr && audioProcessor.mainbuffer->getNumSamples() > 0)
+    {
+        // Generated sounds live in memory unless they were exported
+        showMainBufferThumbnail();
+    }
+    else if (generatedFile.existsAsFile())
     {
         thumbnail.setSource(new juce::FileInputSource(generatedFile));
         repaint();
@@ -510,15 +571,12 @@ bool ImagineAudioProcessorEditor::keyPressed(const juce::KeyPress& key, juce::Co
         juce::File selectedFile = presetlistbox.getSelectedFile();
         if (selectedFile.exists()) {
             thumbnail.clear(); // Clear the thumbnail first
-            juce::File loadFile = audioProcessor.loadFileSound(selectedFile);
-            if (loadFile.existsAsFile())
+            if (audioProcessor.loadFileSound(selectedFile))
             {
                 startPosition = 0;
                 endPosition = audioProcessor.mainbuffer->getNumSamples();
                 thumbnailCache.clear();
-                thumbnail.clear();
-                thumbnail.setSource(new juce::FileInputSource(loadFile));
-                juce::Timer::callAfterDelay(500, [this]() { repaint(); });
+                showMainBufferThumbnail();
             }
             else
             {
@@ -807,15 +865,12 @@ void ImagineAudioProcessorEditor::mouseDown(const juce::MouseEvent& event)
         juce::File selectedFile = presetlistbox.getSelectedFile();
         if (selectedFile.exists()) {
 
-            juce::File loadFile = audioProcessor.loadFileSound(selectedFile);
-            if (loadFile.existsAsFile())
+            if (audioProcessor.loadFileSound(selectedFile))
             {
                 startPosition = 0;
                 endPosition = audioProcessor.mainbuffer->getNumSamples();
                 thumbnailCache.clear();
-                thumbnail.clear(); // Clear the thumbnail first
-                thumbnail.setSource(new juce::FileInputSource(loadFile));
-                juce::Timer::callAfterDelay(500, [this]() { repaint(); });
+                showMainBufferThumbnail();
             }
             else
             {
@@ -895,14 +950,13 @@ void ImagineAudioProcessorEditor::buttonClicked(juce::Button* button)
             if (extension == ".imag")
             {
                 DBG("Loading from file: " + result.getFullPathName());
-                juce::File loadFile = audioProcessor.loadFileSound(result);
-                juce::File resultFile(loadFile);
-                startPosition = 0;
-                endPosition = audioProcessor.mainbuffer->getNumSamples();
-                thumbnail.clear();
-                thumbnailCache.clear();
-                thumbnail.setSource(new juce::FileInputSource(resultFile));
-                juce::Timer::callAfterDelay(500, [this]() { repaint(); });
+                if (audioProcessor.loadFileSound(result))
+                {
+                    startPosition = 0;
+                    endPosition = audioProcessor.mainbuffer->getNumSamples();
+                    thumbnailCache.clear();
+                    showMainBufferThumbnail();
+                }
             }
         }
         else
@@ -912,6 +966,51 @@ void ImagineAudioProcessorEditor::buttonClicked(juce::Button* button)
         delete chooser;
             });
     }
+    else if (button == &liveButton)
+    {
+        audioProcessor.liveRegenerator->setEnabled(liveButton.getToggleState());
+    }
+    else if (button == &sweepButton)
+    {
+        showSweepDialog();
+    }
+    else if (button == &watchButton)
+    {
+        auto& watchFolder = *audioProcessor.watchFolder;
+
+        if (watchFolder.isWatching())
+        {
+            watchFolder.stop();
+            watchButton.setButtonText("Watch Folder");
+            return;
+        }
+
+        auto* chooser = new juce::FileChooser("Watch Folder", juce::File());
+        chooser->launchAsync(juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectDirectories,
+            [this, chooser](const juce::FileChooser& fc)
+            {
+                auto folder = fc.getResult();
+                auto& watchFolder = *audioProcessor.watchFolder;
+                juce::Component::SafePointer<ImagineAudioProcessorEditor> safeThis(this);
+
+                watchFolder.setOnConverted([safeThis](const juce::File&, const juce::File& output)
+                {
+                    if (safeThis == nullptr)
+                        return;
+
+                    safeThis->imgstate = "Watching: converted " + output.getFileName().toStdString();
+                    safeThis->repaint();
+                });
+
+                if (folder.isDirectory() && watchFolder.start(folder))
+                {
+                    imgstate = "Watching " + folder.getFullPathName().toStdString();
+                    watchButton.setButtonText("Stop Watching");
+                    repaint();
+                }
+                delete chooser;
+            });
+    }
     if (button == &helpbutton)
     {
         if (!helpWindow)
@@ -1109,6 +1208,9 @@ void ImagineAudioProcessorEditor::resized()
     int buttonHeight = 30;
     saveButton.setBounds(0, bottomBounds.getY() - 35, 60, buttonHeight);
     loadButton.setBounds(70, bottomBounds.getY() - 35, 60, buttonHeight);
+    watchButton.setBounds(140, bottomBounds.getY() - 35, 100, buttonHeight);
+    liveButton.setBounds(250, bottomBounds.getY() - 35, 70, buttonHeight);
+    sweepButton.setBounds(330, bottomBounds.getY() - 35, 70, buttonHeight);
     helpbutton.setBounds(rightcorner - 20, bottomBounds.getY() - 35, 60, buttonHeight);
     toggleWindow.setBounds(rightcorner - 130, bottomBounds.getY() - 35, 100, buttonHeight);
 
@@ -1173,6 +1275,10 @@ void ImagineAudioProcessorEditor::filesDropped(const juce::StringArray& files, i
     windowComponent->getLfoIntensitySlider().setValue(audioProcessor.lfoIntensity->get());
     windowComponent->getOvertoneNumScalarSlider().setValue(audioProcessor.overtoneNumScalar->get());
     windowComponent->getLfoAmountScalarSlider().setValue(audioProcessor.lfoAmountScalar->get());
+    windowComponent->getTraversalBox().setSelectedId(audioProcessor.traversal->getIndex() + 1);
+    windowComponent->getFmDepthSourceBox().setSelectedId(audioProcessor.fmDepthSource->getIndex() + 1);
+    windowComponent->getOvertoneSourceBox().setSelectedId(audioProcessor.overtoneSource->getIndex() + 1);
+    windowComponent->getLfoRateSourceBox().setSelectedId(audioProcessor.lfoRateSource->getIndex() + 1);
 
 
     documentsDir = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory);
@@ -1185,15 +1291,24 @@ void ImagineAudioProcessorEditor::filesDropped(const juce::StringArray& files, i
         juce::File imageFile(file);
         if (imageFile.hasFileExtension("imag"))
         {
-            juce::File loadFile = audioProcessor.loadFileSound(file);
-            juce::File resultFile(loadFile);
-            thumbnail.clear();
-            thumbnail.setSource(new juce::FileInputSource(resultFile));
-            repaint();
+            if (audioProcessor.loadFileSound(file))
+                showMainBufferThumbnail();
             return;
         }
         imagePath = imageFile.getFullPathName().toStdString();
+
+        if (ImageLoader::isSupportedImage(imageFile))
+        {
+            readImageSizeAsync(imageFile);
+            audioProcessor.generationQueue->preload(imageFile, audioProcessor.kernel->get(), audioProcessor.stepSize->get());
+            audioProcessor.liveRegenerator->setImage(imageFile);
+        }
     }
+
+    // A Generate is likely next, so have numpy and scipy loaded by then
+    if (!audioProcessor.useNativeGenerator)
+        audioProcessor.warmUpPython();
+
     slider_window->setVisible(true);
 
 }
@@ -1222,47 +1337,196 @@ juce::File ImagineAudioProcessorEditor::createFolderIfNotExists(const juce::File
     return folder;
 }
 
-void ImagineAudioProcessorEditor::generateSound()
+void ImagineAudioProcessorEditor::generateSound(std::vector<ParameterSweep::Axis> sweep)
 {
     // Clear the existing thumbnail and sounds
     thumbnail.clear();
     thumbnailCache.clear();
     repaint();
     audioProcessor.mSampler.clearSounds();
+    applyAutoResolution();
+
+    GenerationRequest request;
+    request.imagePath = imagePath;
+    request.outputPath = outputPath;
+    request.useNativeGenerator = audioProcessor.useNativeGenerator || !sweep.empty();     // sweeps are native only
+    request.exportFile = audioProcessor.exportGeneratedSound;
+    request.sweep = std::move(sweep);
+    request.autoResolutionFeatures = audioProcessor.autoResolution ? audioProcessor.autoResolutionFeatures : 0;
+
+    auto& params = request.params;
+    params.kernelSize = (int)windowComponent->getKernelSlider().getValue();
+    params.stepSize = (int)windowComponent->getStepSlider().getValue();
+    params.soundLevel = (float)windowComponent->getSoundLevelSlider().getValue();
+    params.soundDuration = (float)windowComponent->getSoundDurationSlider().getValue();
+    params.modulationDuration = (float)windowComponent->getModulationDurationSlider().getValue();
+    params.modulationIntensity = (float)windowComponent->getModulationIntensitySlider().getValue();
+    params.modulationEnvelopeIntensity = (float)windowComponent->getModulationEnvelopeIntensitySlider().getValue();
+    params.overtoneNumScalar = (float)windowComponent->getOvertoneNumScalarSlider().getValue();
+    params.lfoScalarFreq = (float)windowComponent->getLfoScalarFreqSlider().getValue();
+    params.lfoScalarAmplitude = (float)windowComponent->getLfoScalarAmplitudeSlider().getValue();
+    params.lfoIntensity = (float)windowComponent->getLfoIntensitySlider().getValue();
+    params.lfoAmountScalar = (float)windowComponent->getLfoAmountScalarSlider().getValue();
+    params.traversal = (TraversalOrder)juce::jmax(0, windowComponent->getTraversalBox().getSelectedId() - 1);
+    params.fmDepthSource = (FeatureSource)juce::jmax(0, windowComponent->getFmDepthSourceBox().getSelectedId() - 1);
+    params.overtoneSource = (FeatureSource)juce::jmax(0, windowComponent->getOvertoneSourceBox().getSelectedId() - 1);
+    params.lfoRateSource = (FeatureSource)juce::jmax(0, windowComponent->getLfoRateSourceBox().getSelectedId() - 1);
+    params.sampleRate = audioProcessor.getSampleRate() > 0.0 ? audioProcessor.getSampleRate() : 44100.0;
+
+    // Runs on the processor's generation thread; a newer press supersedes this one
+    juce::Component::SafePointer<ImagineAudioProcessorEditor> safeThis(this);
+
+    audioProcessor.generationQueue->submit(std::move(request),
+        [safeThis](GenerationStage stage, float progress)
+        {
+            if (safeThis != nullptr)
+                safeThis->windowComponent->setGenerationProgress(stage, progress);
+        },
+        [safeThis](const GenerationResult& result)
+        {
+            if (safeThis != nullptr)
+                safeThis->onGenerationFinished(result);
+        });
+}
 
-    // Generate sound by calling the Python function
-    audioProcessor.callPythonFunction(imagePath,
-        outputPath,
-        (int)windowComponent->getKernelSlider().getValue(),
-        (int)windowComponent->getStepSlider().getValue(),
-        windowComponent->getSoundLevelSlider().getValue(),
-        windowComponent->getSoundDurationSlider().getValue(),
-        windowComponent->getModulationDurationSlider().getValue(),
-        windowComponent->getModulationIntensitySlider().getValue(),
-        windowComponent->getModulationEnvelopeIntensitySlider().getValue(),
-        windowComponent->getOvertoneNumScalarSlider().getValue(),
-        windowComponent->getLfoScalarFreqSlider().getValue(),
-        windowComponent->getLfoScalarAmplitudeSlider().getValue(),
-        windowComponent->getLfoIntensitySlider().getValue(),
-        windowComponent->getLfoAmountScalarSlider().getValue());
-
-
-    // Load the generated sound
-    audioProcessor.loadSound(audioProcessor.outputpath);
-
-    // Verify that the output file exists and set it as the source
-    DBG("Path is " + audioProcessor.outputpath.getFileName());
-    juce::File generatedFile(audioProcessor.outputpath);
-    if (generatedFile.existsAsFile())
+void ImagineAudioProcessorEditor::applyAutoResolution()
+{
+    const juce::File image(imagePath);
+    if (!audioProcessor.autoResolution || !ImageLoader::isSupportedImage(image))
+        return;
+
+    // Applied again once readImageSizeAsync has the size
+    if (image != sizedImage || imageWidth <= 0 || imageHeight <= 0)
+        return;
+
+    const double sampleRate = audioProcessor.getSampleRate() > 0.0 ? audioProcessor.getSampleRate() : 44100.0;
+
+    const auto choice = AutoResolution::choose(imageWidth, imageHeight, windowComponent->getSoundDurationSlider().getValue(),
+                                               sampleRate, audioProcessor.autoResolutionFeatures);
+
+    // Through the sliders, so the processor's parameters and live mode follow
+    windowComponent->getKernelSlider().setValue(choice.kernelSize);
+    windowComponent->getStepSlider().setValue(choice.stepSize);
+
+    DBG("Auto resolution: kernel " << choice.kernelSize << ", step " << choice.stepSize << ", " << choice.numFeatures << " windows");
+}
+
+void ImagineAudioProcessorEditor::readImageSizeAsync(const juce::File& file)
+{
+    if (file == sizedImage)
+    {
+        applyAutoResolution();
+        return;
+    }
+
+    sizedImage = file;
+    imageWidth = imageHeight = 0;
+
+    juce::Component::SafePointer<ImagineAudioProcessorEditor> safeThis(this);
+    juce::Thread::launch([safeThis, file]
+        {
+            int width = 0, height = 0;
+            if (!AutoResolution::readProcessedSize(file, width, height))
+                return;
+
+            juce::MessageManager::callAsync([safeThis, file, width, height]
+                {
+                    if (safeThis == nullptr || safeThis->sizedImage != file)
+                        return;
+
+                    safeThis->imageWidth = width;
+                    safeThis->imageHeight = height;
+                    safeThis->applyAutoResolution();
+                });
+        });
+}
+
+void ImagineAudioProcessorEditor::showSweepDialog()
+{
+    if (imagePath.empty())
     {
+        imgstate = "Drop an image before sweeping";
+        repaint();
+        return;
+    }
+
+    juce::StringArray names;
+    for (int i = 0; i < ParameterSweep::numParameters; ++i)
+        names.add(ParameterSweep::getName((ParameterSweep::Parameter)i));
+
+    auto* dialog = new juce::AlertWindow("Parameter Sweep",
+        "Renders one file per value, into a folder next to the other exports. The other parameters come from the sliders.",
+        juce::MessageBoxIconType::NoIcon);
+
+    dialog->addComboBox("parameter", names, "Parameter");
+    dialog->getComboBoxComponent("parameter")->setSelectedItemIndex((int)ParameterSweep::Parameter::lfoIntensity);
+    dialog->addTextEditor("values", "0.25, 0.5, 1, 2", "Values");
+    dialog->addButton("Render", 1, juce::KeyPress(juce::KeyPress::returnKey));
+    dialog->addButton("Cancel", 0, juce::KeyPress(juce::KeyPress::escapeKey));
+
+    juce::Component::SafePointer<ImagineAudioProcessorEditor> safeThis(this);
+
+    dialog->enterModalState(true, juce::ModalCallbackFunction::create([safeThis, dialog](int choice)
+        {
+            if (choice != 1 || safeThis == nullptr)
+                return;
+
+            ParameterSweep::Axis axis{ (ParameterSweep::Parameter)dialog->getComboBoxComponent("parameter")->getSelectedItemIndex(), {} };
+
+            juce::StringArray values;
+            values.addTokens(dialog->getTextEditorContents("values"), ", ", "");
+            values.removeEmptyStrings();
+
+            for (const auto& value : values)
+                axis.values.push_back(value.getDoubleValue());
+
+            if (!axis.values.empty())
+                safeThis->generateSound({ axis });
+        }), true);
+}
+
+void ImagineAudioProcessorEditor::showMainBufferThumbnail()
+{
+    const auto& sound = *audioProcessor.mainbuffer;
+
+    thumbnail.clear();
+    thumbnail.reset(sound.getNumChannels(), audioProcessor.mainbufferSampleRate, sound.getNumSamples());
+    thumbnail.addBlock(0, sound, 0, sound.getNumSamples());
+    repaint();
+}
+
+void ImagineAudioProcessorEditor::onGenerationFinished(const GenerationResult& result)
+{
+    windowComponent->setGenerationProgress({}, -1.0f);
+
+    if (result.sound != nullptr)
+    {
+        // Rendered in memory: hand the buffer over and draw the thumbnail from it
+        audioProcessor.setGeneratedSound(result.sound, result.sampleRate);
+
         startPosition = 0;
         endPosition = audioProcessor.mainbuffer->getNumSamples();
-        thumbnail.setSource(new juce::FileInputSource(generatedFile));
-        repaint();  // Repaint to show the updated thumbnail
+        showMainBufferThumbnail();
+    }
+    else if (result.outputFile.existsAsFile())
+    {
+        // The Python batch path only leaves files behind
+        juce::File generatedFile(result.outputFile);
+        DBG("Path is " + generatedFile.getFileName());
+
+        audioProcessor.outputpath = generatedFile;
+        audioProcessor.loadSound(audioProcessor.outputpath);
+
+        if (audioProcessor.mainbuffer != nullptr)
+        {
+            startPosition = 0;
+            endPosition = audioProcessor.mainbuffer->getNumSamples();
+            showMainBufferThumbnail();
+        }
     }
     else
     {
-        DBG("Generated file does not exist: ");
+        DBG("Generation produced no sound");
     }
 
     // Clear selected block if it exists
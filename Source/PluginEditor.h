@@ -193,7 +193,12 @@ public:
     {
         this->imageFile = imageFile;
     }
-    void generateSound();
+    void generateSound(std::vector<ParameterSweep::Axis> sweep = {});
+    void showSweepDialog();
+    void applyAutoResolution();     // if enabled, sets kernel and step for the current image
+    void readImageSizeAsync(const juce::File& file);    // caches the size off the message thread, then applies it
+    void onGenerationFinished(const GenerationResult& result);
+    void showMainBufferThumbnail();
 
     int startPosition, endPosition;
 
@@ -213,6 +218,9 @@ public:
 
     juce::TextButton saveButton;
     juce::TextButton loadButton;
+    juce::TextButton watchButton;
+    juce::ToggleButton liveButton;
+    juce::TextButton sweepButton;
     juce::TextButton toggleWindow;
     juce::TextButton refreshPreset;
 
@@ -224,6 +232,10 @@ public:
     void restoreFilterState();
     std::string getFilterType(int type);
 
+    // The current image's size, for auto resolution; 0 until it has been read
+    juce::File sizedImage;
+    int imageWidth = 0, imageHeight = 0;
+
 
 private:
     // This reference is provided as a quick way for your editor to
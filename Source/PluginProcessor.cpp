@@ -8,11 +8,44 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "PyNativeModule.h"
+#include "ImageLoader.h"
+#include "ImageFeatures.h"
+#include "TiledImageReader.h"
+#include "BufferAudioFormatReader.h"
 #include <string>
+#include <vector>
 #include <filesystem>
 
 namespace fs = std::filesystem;
 
+//==============================================================================
+class ImagineAudioProcessor::LegacyDurationMapping : private juce::AudioProcessorParameter::Listener
+{
+public:
+    LegacyDurationMapping(juce::AudioParameterInt& legacy, juce::AudioParameterInt& target)
+        : legacyDuration(legacy), duration(target)
+    {
+        legacyDuration.addListener(this);
+    }
+
+    ~LegacyDurationMapping() override
+    {
+        legacyDuration.removeListener(this);
+    }
+
+private:
+    void parameterValueChanged(int, float) override
+    {
+        duration.setValueNotifyingHost(duration.convertTo0to1((float)legacyDuration.get()));
+    }
+
+    void parameterGestureChanged(int, bool) override {}
+
+    juce::AudioParameterInt& legacyDuration;
+    juce::AudioParameterInt& duration;
+};
+
 //==============================================================================
 ImagineAudioProcessor::ImagineAudioProcessor()
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -47,11 +80,17 @@ ImagineAudioProcessor::ImagineAudioProcessor()
 
 
 
-    Py_Initialize();
+    // The interpreter isn't started here: hosts construct plugins while
+    // scanning, so Python only comes up when a render first needs it
     currentPath = juce::File::getCurrentWorkingDirectory();
     root = currentPath;
 
-    pyEmbedder = std::make_unique<Pyembedder>();
+    generationQueue = std::make_unique<GenerationQueue>(*this);
+
+    const auto watchOutput = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+        .getChildFile("Imagine").getChildFile("output");
+    watchFolder = std::make_unique<WatchFolder>([this] { return getGenerationParameters(); },
+        (watchOutput.getFullPathName() + juce::File::getSeparatorString()).toStdString());
 
 
 
@@ -92,7 +131,9 @@ ImagineAudioProcessor::ImagineAudioProcessor()
     addParameter(kernel = new juce::AudioParameterInt("kernel", "kernel", 0, 50, 25));
     addParameter(stepSize = new juce::AudioParameterInt("stepSize", "Step Size", 0, 50, 10));
     addParameter(level = new juce::AudioParameterFloat("level", "Level", 0, 10, 1));
-    addParameter(duration = new juce::AudioParameterInt("duration", "Duration", 0, 30, 10));
+    // Keeps its ID, range and place so existing automation still lands on it;
+    // the 0-300 s duration is added at the end of the list
+    addParameter(legacyDuration = new juce::AudioParameterInt("duration", "Duration (up to 30 s)", 0, 30, 10));
 
     addParameter(filter1Type = new juce::AudioParameterInt("filter1Type", "Filter1 Type", 0, 4, 0));
     addParameter(filter2Type = new juce::AudioParameterInt("filter2Type", "Filter2 Type", 0, 4, 0));
@@ -118,12 +159,30 @@ ImagineAudioProcessor::ImagineAudioProcessor()
     addParameter(overtoneNumScalar = new juce::AudioParameterFloat("overtoneNumScalar", "Overtone Num Scalar", 0.0f, 4.0f, 1.0f));
     addParameter(lfoAmountScalar = new juce::AudioParameterFloat("lfoAmountScalar", "Lfo Amount Scalar", 0.0f, 4.0f, 1.0f));
 
+    juce::StringArray orders = { "Raster", "Column-major", "Serpentine", "Spiral", "Hilbert" };
+    addParameter(traversal = new juce::AudioParameterChoice("traversal", "Window Order", orders, 0));
+
+    juce::StringArray sources = { "None", "Saturation", "Brightness", "Luminance variance", "Edge density" };
+    addParameter(fmDepthSource = new juce::AudioParameterChoice("fmDepthSource", "FM Depth Source", sources, 0));
+    addParameter(overtoneSource = new juce::AudioParameterChoice("overtoneSource", "Overtone Source", sources, 0));
+    addParameter(lfoRateSource = new juce::AudioParameterChoice("lfoRateSource", "Lfo Rate Source", sources, 0));
+
+    addParameter(duration = new juce::AudioParameterInt("soundDuration", "Duration", 0, 300, 10));
+    legacyDurationMapping = std::make_unique<LegacyDurationMapping>(*legacyDuration, *duration);
+
+    liveRegenerator = std::make_unique<LiveRegenerator>(*this, juce::Array<juce::AudioProcessorParameter*>{
+        kernel, stepSize, level, duration,
+        modulationIntensity, modulationEnvelopeIntensity, modulationDuration,
+        lfoScalarFreq, lfoScalarAmplitude, lfoIntensity, overtoneNumScalar, lfoAmountScalar, traversal,
+        fmDepthSource, overtoneSource, lfoRateSource });
 }
 
 ImagineAudioProcessor::~ImagineAudioProcessor()
 {
-    Py_Finalize();
-    this->mFormatReader = nullptr;
+    legacyDurationMapping.reset();
+    liveRegenerator.reset();
+    watchFolder.reset();
+    generationQueue.reset();
 }
 
 //==============================================================================
@@ -374,8 +433,30 @@ juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
     return new ImagineAudioProcessor();
 }
 
+GenerationParameters ImagineAudioProcessor::getGenerationParameters() const
+{
+    GenerationParameters params;
+    params.kernelSize = kernel->get();
+    params.stepSize = stepSize->get();
+    params.soundLevel = level->get();
+    params.soundDuration = (float)duration->get();
+    params.modulationIntensity = modulationIntensity->get();
+    params.modulationEnvelopeIntensity = modulationEnvelopeIntensity->get();
+    params.modulationDuration = modulationDuration->get();
+    params.lfoScalarFreq = lfoScalarFreq->get();
+    params.lfoScalarAmplitude = lfoScalarAmplitude->get();
+    params.lfoIntensity = lfoIntensity->get();
+    params.overtoneNumScalar = overtoneNumScalar->get();
+    params.lfoAmountScalar = lfoAmountScalar->get();
+    params.traversal = (TraversalOrder)traversal->getIndex();
+    params.fmDepthSource = (FeatureSource)fmDepthSource->getIndex();
+    params.overtoneSource = (FeatureSource)overtoneSource->getIndex();
+    params.lfoRateSource = (FeatureSource)lfoRateSource->getIndex();
+    params.sampleRate = getSampleRate() > 0.0 ? getSampleRate() : 44100.0;
+    return params;
+}
 
-void ImagineAudioProcessor::callPythonFunction(const std::string& img_path,
+GenerationResult ImagineAudioProcessor::callPythonFunction(const std::string& img_path,
     const std::string& out_path,
     int kernel_size,
     int step_size,
@@ -389,98 +470,230 @@ void ImagineAudioProcessor::callPythonFunction(const std::string& img_path,
     float lfo_scalar_amplitude,
     float lfo_intensity,
     float lfo_amount_scalar) {
-    // Run the embedded Python code
-    std::string fullPythonCode = std::string(pyEmbedder->Pythoncode1) +
-        std::string(pyEmbedder->Pythoncode2) +
-        std::string(pyEmbedder->Pythoncode3) +
-        std::string(pyEmbedder->Pythoncode4) +
-        std::string(pyEmbedder->Pythoncode5) +
-        std::string(pyEmbedder->Pythoncode6) +
-        std::string(pyEmbedder->Pythoncode7) +
-        std::string(pyEmbedder->Pythoncode8) +
-        std::string(pyEmbedder->Pythoncode9) +
-        std::string(pyEmbedder->Pythoncode10) +
-        std::string(pyEmbedder->Pythoncode11);
-
-    // Use fullPythonCode where needed to execute or pass to the Python interpreter.
-    PyRun_SimpleString(fullPythonCode.c_str());
-
-    // Access the "__main__" module to retrieve the embedded function
-    PyObject* mainModule = PyImport_AddModule("__main__");
-    PyObject* globalDict = PyModule_GetDict(mainModule);
-    PyObject* pFunc = PyDict_GetItemString(globalDict, "main_generation_handler");
+    GenerationResult result;
+    result.sampleRate = (double)(long)getSampleRate();
+
+   #if !IMAGINE_ENABLE_PYTHON
+    juce::ignoreUnused(img_path, out_path, kernel_size, step_size, sound_level, sound_duration, modulation_duration,
+                       modulation_intensity, modulation_envelope_intensity, overtone_num_scalar, lfo_scalar_freq,
+                       lfo_scalar_amplitude, lfo_intensity, lfo_amount_scalar);
+    DBG("Built without the Python generator (IMAGINE_ENABLE_PYTHON=0)");
+    return result;
+   #else
+    // Starts the interpreter on first use; must happen before taking the GIL
+    PythonGenerator* pythonGenerator = python->getGenerator();
+    if (pythonGenerator == nullptr)
+    {
+        DBG("Could not start the Python interpreter");
+        return result;
+    }
 
-    if (pFunc && PyCallable_Check(pFunc)) {
-        // Create arguments for main_generation_handler
-        PyObject* pArgs = PyTuple_Pack(15,
-            PyUnicode_FromString(img_path.c_str()),
-            PyUnicode_FromString(out_path.c_str()),
-            PyLong_FromLong(kernel_size),
-            PyLong_FromLong(step_size),
-            PyLong_FromLong(sound_level),
-            PyLong_FromLong(getSampleRate()),
-            PyLong_FromLong(sound_duration),
-            PyLong_FromLong(modulation_duration),
-            PyFloat_FromDouble(modulation_intensity),
-            PyFloat_FromDouble(modulation_envelope_intensity),
-            PyFloat_FromDouble(overtone_num_scalar),
-            PyFloat_FromDouble(lfo_scalar_freq),
-            PyFloat_FromDouble(lfo_scalar_amplitude),
-            PyFloat_FromDouble(lfo_intensity),
-            PyFloat_FromDouble(lfo_amount_scalar)
-        );
+    ScopedGIL gil;
 
-        // Call the Python function
-        PyObject* pValue = PyObject_CallObject(pFunc, pArgs);
+    // The arguments generate_sound and main_generation_handler share: generate_sound's
+    // keyword names, in main_generation_handler's order after img_path, out_path,
+    // kernel_size and step_size. Each object is a new reference.
+    auto makeSoundArgs = [&]() -> std::vector<std::pair<const char*, PyObject*>>
+    {
+        return {
+            { "sound_level", PyLong_FromLong(sound_level) },
+            { "sample_rate", PyLong_FromLong(getSampleRate()) },
+            { "sound_duration", PyLong_FromLong(sound_duration) },
+            { "modulation_duration", PyLong_FromLong(modulation_duration) },
+            { "modulation_intensity", PyFloat_FromDouble(modulation_intensity) },
+            { "modulation_envelope_intensity", PyFloat_FromDouble(modulation_envelope_intensity) },
+            { "overtone_num_scalar", PyFloat_FromDouble(overtone_num_scalar) },
+            { "lfo_scalar_freq", PyFloat_FromDouble(lfo_scalar_freq) },
+            { "lfo_scalar_amplitude", PyFloat_FromDouble(lfo_scalar_amplitude) },
+            { "lfo_intensity", PyFloat_FromDouble(lfo_intensity) },
+            { "lfo_amount_scalar", PyFloat_FromDouble(lfo_amount_scalar) }
+        };
+    };
+
+    // Single images are decoded and convolved natively, then handed straight
+    // to generate_sound, which renders into our buffer. Folders and anything
+    // JUCE can't decode go through main_generation_handler and WAV files.
+    juce::File imageFile(img_path);
+    if (imageFile.existsAsFile() && ImageLoader::isSupportedImage(imageFile))
+    {
+        // Images too large to decode are read in strips at full resolution instead
+        const bool tiled = TiledImageReader::shouldUse(imageFile);
+        PlanarImage image = tiled ? PlanarImage() : ImageLoader::load(imageFile, kernel_size, step_size);
 
-        if (pValue != nullptr) {
-            if (PyUnicode_Check(pValue)) { // Ensure the return type is a string
-                const char* resultCStr = PyUnicode_AsUTF8(pValue);
-                std::string resultStr = resultCStr;  // Convert to std::string if needed
-                juce::Logger::outputDebugString("Returned string from Python: " + resultStr);
-                this->outputpath = resultCStr; // Set output path from result
+        if (tiled || !image.isEmpty())
+        {
+            ImageFeatures features;
+            try
+            {
+                if (tiled)
+                {
+                    features = TiledImageReader::computeBlockMeans(imageFile, kernel_size, step_size);
+                }
+                else
+                {
+                    IntegralImage integral;
+                    integral.build(image);
+                    features = integral.computeBlockMeans(kernel_size, step_size);
+                }
             }
-            else {
-                juce::Logger::outputDebugString("Error: Python function did not return a string.");
+            catch (const std::exception& e)
+            {
+                juce::ignoreUnused(e);
+                DBG("Feature extraction failed: " << e.what());
+                return result;
             }
 
-            Py_DECREF(pValue); // Release the Python object
-        }
-        else {
-            PyErr_Print();
-            juce::Logger::outputDebugString("Call to Python function failed");
+            if (features.isEmpty())
+                return result;
+
+            // np.arange(0, duration, 1 / rate) can come out one sample longer than duration * rate
+            const int numSamples = (int)std::ceil(sound_duration * result.sampleRate) + 1;
+            auto sound = std::make_shared<juce::AudioBuffer<float>>(1, juce::jmax(1, numSamples));
+            sound->clear();
+
+            PyObject* pFunc = pythonGenerator->getGenerateSound();
+            PyObject* rgbDict = createFeatureDict(std::make_shared<const ImageFeatures>(std::move(features)));
+            PyObject* audioOut = createAudioBuffer(sound, 0);
+
+            if (pFunc == nullptr || !PyCallable_Check(pFunc) || rgbDict == nullptr || audioOut == nullptr)
+            {
+                if (PyErr_Occurred())
+                    PyErr_Print();
+                Py_XDECREF(rgbDict);
+                Py_XDECREF(audioOut);
+                DBG("Cannot find function generate_sound");
+                return result;
+            }
+
+            PyObject* pKwargs = PyDict_New();
+            auto setArg = [pKwargs](const char* name, PyObject* value)
+            {
+                PyDict_SetItemString(pKwargs, name, value);
+                Py_DECREF(value);
+            };
+
+            setArg("rgb_dict", rgbDict);
+            setArg("out_path", PyUnicode_FromString(out_path.c_str()));
+            setArg("file_name", PyUnicode_FromString(imageFile.getFileNameWithoutExtension().toRawUTF8()));
+            setArg("audio_out", audioOut);
+
+            for (const auto& [name, value] : makeSoundArgs())
+                setArg(name, value);
+
+            PyObject* pArgs = PyTuple_New(0);
+            PyObject* pValue = PyObject_Call(pFunc, pArgs, pKwargs);
+
+            // generate_sound returns (dominant_color, samples_written) when given audio_out
+            const char* colour = nullptr;
+            int samplesWritten = 0;
+
+            if (pValue != nullptr && PyTuple_Check(pValue) && PyArg_ParseTuple(pValue, "si", &colour, &samplesWritten))
+            {
+                sound->setSize(1, juce::jlimit(0, sound->getNumSamples(), samplesWritten), true, false, true);
+                result.sound = sound;
+                result.name = imageFile.getFileNameWithoutExtension() + "_output_" + juce::String(colour);
+            }
+            else
+            {
+                if (PyErr_Occurred())
+                    PyErr_Print();
+                DBG("Call to generate_sound failed");
+            }
+
+            Py_XDECREF(pValue);
+            Py_DECREF(pArgs);
+            Py_DECREF(pKwargs);
+            return result;
         }
+    }
+
+    PyObject* pFunc = pythonGenerator->getMainGenerationHandler();
+
+    if (pFunc && PyCallable_Check(pFunc)) {
+        // Create arguments for main_generation_handler. PyTuple_SetItem takes
+        // over each reference.
+        const auto soundArgs = makeSoundArgs();
+        PyObject* pArgs = PyTuple_New(4 + (Py_ssize_t)soundArgs.size());
+        PyTuple_SetItem(pArgs, 0, PyUnicode_FromString(img_path.c_str()));
+        PyTuple_SetItem(pArgs, 1, PyUnicode_FromString(out_path.c_str()));
+        PyTuple_SetItem(pArgs, 2, PyLong_FromLong(kernel_size));
+        PyTuple_SetItem(pArgs, 3, PyLong_FromLong(step_size));
+
+        for (size_t i = 0; i < soundArgs.size(); ++i)
+            PyTuple_SetItem(pArgs, 4 + (Py_ssize_t)i, soundArgs[i].second);
+
+        // Call the Python function
+        PyObject* pValue = PyObject_CallObject(pFunc, pArgs);
+        result.outputFile = takeGeneratedPath(pValue);
 
         Py_DECREF(pArgs);
     }
     else {
         if (PyErr_Occurred())
             PyErr_Print();
-        juce::Logger::outputDebugString("Cannot find function main_generation_handler");
+        DBG("Cannot find function main_generation_handler");
     }
 
+    return result;
+   #endif
 }
 
+#if IMAGINE_ENABLE_PYTHON
+juce::File ImagineAudioProcessor::takeGeneratedPath(PyObject* pValue)
+{
+    juce::File generated;
+
+    if (pValue != nullptr) {
+        if (PyUnicode_Check(pValue)) { // Ensure the return type is a string
+            const char* resultCStr = PyUnicode_AsUTF8(pValue);
+            std::string resultStr = resultCStr;  // Convert to std::string if needed
+            DBG("Returned string from Python: " << resultStr);
+            generated = juce::File(juce::String::fromUTF8(resultCStr));
+        }
+        else {
+            DBG("Error: Python function did not return a string.");
+        }
 
-void ImagineAudioProcessor::loadSound(juce::File& filepath) {
-    juce::BigInteger range;
-    range.setRange(0, 128, true);
-    mFormatReader = mFormatManager.createReaderFor(filepath);
+        Py_DECREF(pValue); // Release the Python object
+    }
+    else {
+        PyErr_Print();
+        DBG("Call to Python function failed");
+    }
 
-    int numChannels = static_cast<int>(mFormatReader->numChannels);
-    int numSamples = static_cast<int>(mFormatReader->lengthInSamples);
+    return generated;
+}
+#endif
 
 
-    auto sampleLength = static_cast<int>(mFormatReader->lengthInSamples);
+void ImagineAudioProcessor::loadSound(juce::File& filepath) {
+    // Decode once into float; the sampler is built from the same buffer
     std::unique_ptr<juce::AudioFormatReader> reader(mFormatManager.createReaderFor(filepath));
 
     if (reader != nullptr) {
-
-        mainbuffer = std::make_unique<juce::AudioBuffer<float>>(reader->numChannels, reader->lengthInSamples);
-        reader->read(mainbuffer.get(), 0, reader->lengthInSamples, 0, true, true);
+        auto sound = std::make_shared<juce::AudioBuffer<float>>((int)reader->numChannels, (int)reader->lengthInSamples);
+        reader->read(sound.get(), 0, (int)reader->lengthInSamples, 0, true, true);
+        setGeneratedSound(std::move(sound), reader->sampleRate);
     }
-    mSampler.addSound(new juce::SamplerSound("Sample", *mFormatReader, range, 60, 0.1, 0.1, 10));
+}
+
+void ImagineAudioProcessor::setGeneratedSound(std::shared_ptr<juce::AudioBuffer<float>> sound, double sampleRate)
+{
+    if (sound == nullptr || sound->getNumSamples() == 0)
+        return;
+
+    mainbuffer = std::move(sound);
+    mainbufferSampleRate = sampleRate;
+
+    juce::BigInteger range;
+    range.setRange(0, 128, true);
 
+    // Generated sounds can run longer than the 10 s the file path allows
+    const double lengthSeconds = mainbuffer->getNumSamples() / sampleRate;
+
+    BufferAudioFormatReader reader(*mainbuffer, sampleRate);
+    mSampler.clearSounds();
+    mSampler.addSound(new juce::SamplerSound("Sample", reader, range, 60, 0.1, 0.1, juce::jmax(10.0, lengthSeconds)));
 }
 
 void ImagineAudioProcessor::onBlockChange(int start, int end)
@@ -509,62 +722,14 @@ void ImagineAudioProcessor::onBlockChange(int start, int end)
         }
 
 
-        juce::File outputFile = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
-            .getChildFile("Imagine")
-            .getChildFile("temp")
-            .getChildFile("block.wav");
-        outputFile.deleteFile();
-        // Make sure the directory exists, if not create it
-        if (!outputFile.getParentDirectory().exists())
-        {
-            if (!outputFile.getParentDirectory().createDirectory())
-            {
-                DBG("Error: Failed to create directory: " << outputFile.getParentDirectory().getFullPathName());
-                return;
-            }
-        }
-
-        juce::WavAudioFormat wavFormat;
-        std::unique_ptr<juce::FileOutputStream> outputStream(outputFile.createOutputStream());
-        std::unique_ptr<juce::AudioFormatWriter> writer(wavFormat.createWriterFor(outputStream.get(),
-            getSampleRate(),
-            selectedBlock->getNumChannels(),
-            16,
-            {},
-            0));
-
-        if (writer == nullptr)
-        {
-            DBG("Error Creating WAV File Writer!");
-            return;
-        }
-
-        bool writeResult = writer->writeFromAudioSampleBuffer(*selectedBlock, 0, selectedBlock->getNumSamples());
-        if (!writeResult)
-        {
-            DBG("Error writing to WAV file");
-            return;
-        }
-
-
-        DBG("WAV file saved successfully!");
-        writer->flush();
-        outputStream->flush();
-        outputStream.release();
-        mFormatReader = mFormatManager.createReaderFor(outputFile);
-
-        std::unique_ptr<juce::AudioFormatReader> reader(mFormatManager.createReaderFor(outputFile));
-        if (reader == nullptr)
-        {
-            selectedBlock = std::make_unique<juce::AudioBuffer<float>>(reader->numChannels, reader->lengthInSamples);
-            reader->read(selectedBlock.get(), 0, reader->lengthInSamples, 0, true, true);
-            return;
-        }
+        // The sampler reads the selection straight from memory, still in float
+        BufferAudioFormatReader reader(*selectedBlock, mainbufferSampleRate);
 
         juce::BigInteger selectedRange;
         selectedRange.setRange(0, 128, true);
         mSampler.clearSounds();
-        mSampler.addSound(new juce::SamplerSound("Selected Block", *reader, selectedRange, 60, 0.1, 0.1, 10));
+        mSampler.addSound(new juce::SamplerSound("Selected Block", reader, selectedRange, 60, 0.1, 0.1,
+            juce::jmax(10.0, blockSize / mainbufferSampleRate)));
     }
 }
 
@@ -585,7 +750,7 @@ void ImagineAudioProcessor::saveSound(const juce::File& file)
         }
 
         juce::XmlElement* audioData = new juce::XmlElement("AudioData");
-        int sampleRate = getSampleRate();
+        int sampleRate = (int)mainbufferSampleRate;
         int numChannels = mainbuffer->getNumChannels();
         int numSamples = mainbuffer->getNumSamples();
         audioData->setAttribute("SampleRate", sampleRate);
@@ -615,7 +780,7 @@ void ImagineAudioProcessor::saveSound(const juce::File& file)
 }
 
 
-juce::File ImagineAudioProcessor::loadFileSound(const juce::File& file)
+bool ImagineAudioProcessor::loadFileSound(const juce::File& file)
 {
     if (file.existsAsFile())
     {
@@ -627,7 +792,7 @@ juce::File ImagineAudioProcessor::loadFileSound(const juce::File& file)
             juce::AlertWindow::showMessageBoxAsync(juce::AlertWindow::WarningIcon,
                 "Load Error",
                 "Could not load audio data from file.");
-            return file;
+            return false;
         }
 
         auto* audioData = rootElement->getChildByName("AudioData");
@@ -638,53 +803,29 @@ juce::File ImagineAudioProcessor::loadFileSound(const juce::File& file)
             juce::String base64Audio = audioData->getStringAttribute("AudioData");
 
             juce::MemoryOutputStream decodedAudioStream;
-            if (juce::Base64::convertFromBase64(decodedAudioStream, base64Audio))
+            if (numChannels > 0 && juce::Base64::convertFromBase64(decodedAudioStream, base64Audio))
             {
+                // Stored as planar float32, so it goes straight into the buffer
                 juce::MemoryInputStream memoryStream(decodedAudioStream.getData(), decodedAudioStream.getDataSize(), false);
-                int numSamples = memoryStream.getDataSize() / (numChannels * sizeof(float));
-                juce::AudioBuffer<float> buffer(numChannels, numSamples);
+                int numSamples = (int)(memoryStream.getDataSize() / (numChannels * sizeof(float)));
+                auto buffer = std::make_shared<juce::AudioBuffer<float>>(numChannels, numSamples);
 
                 for (int channel = 0; channel < numChannels; ++channel)
                 {
+                    float* samples = buffer->getWritePointer(channel);
                     for (int sample = 0; sample < numSamples; ++sample)
                     {
-                        buffer.setSample(channel, sample, memoryStream.readFloat());
+                        samples[sample] = memoryStream.readFloat();
                     }
                 }
 
-                juce::File tempWavFile = juce::File::getSpecialLocation(juce::File::SpecialLocationType::tempDirectory).getChildFile("temp.wav");
-                tempWavFile.deleteFile();
-                juce::WavAudioFormat wavFormat;
-                std::unique_ptr<juce::FileOutputStream> tempOutputStream(tempWavFile.createOutputStream());
-                std::unique_ptr<juce::AudioFormatWriter> writer(wavFormat.createWriterFor(tempOutputStream.get(),
-                    sampleRate,
-                    numChannels,
-                    24,
-                    {}, 0));
-
-                if (writer != nullptr)
-                {
-                    writer->writeFromAudioSampleBuffer(buffer, 0, buffer.getNumSamples());
-                    writer->flush();
-                    tempOutputStream->flush();
-                    tempOutputStream.release();
-                }
-
-                std::unique_ptr<juce::AudioFormatReader> reader(mFormatManager.createReaderFor(tempWavFile));
-                if (reader != nullptr)
-                {
-                    mainbuffer = std::make_unique<juce::AudioBuffer<float>>(reader->numChannels, reader->lengthInSamples);
-                    reader->read(mainbuffer.get(), 0, reader->lengthInSamples, 0, true, true);
-
-                    juce::BigInteger range;
-                    range.setRange(0, 128, true);
-                    mSampler.clearSounds();
-                    mSampler.addSound(new juce::SamplerSound("Sample", *reader, range, 60, 0.1, 0.1, 10));
-                }
-                return tempWavFile;
+                setGeneratedSound(std::move(buffer), sampleRate);
+                return true;
             }
         }
     }
+
+    return false;
 }
 
 void ImagineAudioProcessor::setFilter(int filterIndex, std::string type, int frequency, float qFactor)
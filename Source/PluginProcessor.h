@@ -7,18 +7,14 @@
 */
 
 #pragma once
-#include "Pyembedder.h"
+#include "PythonRuntime.h"
+#include "GenerationQueue.h"
+#include "WatchFolder.h"
+#include "LiveRegenerator.h"
+#include "AutoResolution.h"
 #include <JuceHeader.h>
 #include <juce_dsp/juce_dsp.h>
 
-#ifdef _DEBUG
-#undef _DEBUG
-#include <python.h>
-#define _DEBUG
-#else
-#include <python.h>
-#endif
-
 
 
 //==============================================================================
@@ -65,6 +61,8 @@ public:
     void setStateInformation(const void* data, int sizeInBytes) override;
 
     void loadSound(juce::File& soundpath);
+    // Takes a generated sound straight from memory, no WAV round trip
+    void setGeneratedSound(std::shared_ptr<juce::AudioBuffer<float>> sound, double sampleRate);
     bool firstload = true;
     void onBlockChange(int start, int end);
 
@@ -96,7 +94,8 @@ public:
     //===================================================================
     //Gain==============================
 
-    std::unique_ptr<juce::AudioBuffer<float>> mainbuffer;
+    std::shared_ptr<juce::AudioBuffer<float>> mainbuffer;     // shared with generation jobs, never copied
+    double mainbufferSampleRate = 44100.0;
     std::unique_ptr<juce::AudioBuffer<float>> selectedBlock;
     std::unique_ptr<juce::AudioBuffer<float>> firstBlock;
     std::unique_ptr<juce::AudioBuffer<float>> lastBlock;
@@ -159,7 +158,8 @@ public:
     juce::AudioParameterInt* kernel;
     juce::AudioParameterInt* stepSize;
     juce::AudioParameterFloat* level;
-    juce::AudioParameterInt* duration;
+    juce::AudioParameterInt* duration;          // "soundDuration", 0-300 s
+    juce::AudioParameterInt* legacyDuration;    // "duration", the old 0-30 s parameter, mapped onto duration
     juce::AudioParameterFloat* modulationIntensity;
     juce::AudioParameterFloat* modulationEnvelopeIntensity;
     juce::AudioParameterFloat* modulationDuration;
@@ -168,6 +168,10 @@ public:
     juce::AudioParameterFloat* lfoIntensity;
     juce::AudioParameterFloat* overtoneNumScalar;
     juce::AudioParameterFloat* lfoAmountScalar;
+    juce::AudioParameterChoice* traversal;      // index is a TraversalOrder
+    juce::AudioParameterChoice* fmDepthSource;  // index is a FeatureSource
+    juce::AudioParameterChoice* overtoneSource;
+    juce::AudioParameterChoice* lfoRateSource;
 
 
     void updateADSRParameters(float attack, float decay, float sustain, float release);
@@ -177,7 +181,7 @@ public:
     ;
 
 
-    void callPythonFunction(const std::string& img_path,
+    GenerationResult callPythonFunction(const std::string& img_path,
 
         const std::string& out_path,
         int kernel_size,
@@ -192,23 +196,58 @@ public:
         float lfo_scalar_amplitude,
         float lfo_intensity,
         float lfo_amount_scalar);
+
+    // Generate requests run here, off the message thread
+    std::unique_ptr<GenerationQueue> generationQueue;
+    bool useNativeGenerator = true;     // false falls back to the embedded Python generator (see PythonConfig.h)
+
+    // Starts the shared interpreter in the background ahead of a Python render
+   #if IMAGINE_ENABLE_PYTHON
+    void warmUpPython() { python->warmUp(); }
+   #else
+    void warmUpPython() {}
+   #endif
+    bool exportGeneratedSound = false;  // also write each generated sound to a WAV in the output folder
+
+    // Kernel and step follow each image's size and the duration instead of the sliders (see AutoResolution)
+    bool autoResolution = false;
+    int autoResolutionFeatures = AutoResolution::defaultMaxFeatures;
+
+    // Converts images dropped into a folder with the current parameters
+    std::unique_ptr<WatchFolder> watchFolder;
+
+    // Regenerates automatically when a generation parameter moves
+    std::unique_ptr<LiveRegenerator> liveRegenerator;
+
+    // The generation parameters as they currently stand; safe from any thread
+    GenerationParameters getGenerationParameters() const;
+
     std::string pythonpath;
     juce::File currentPath;
     juce::File root;
-    juce::File outputpath;
+    juce::File outputpath;         // the last file loaded from a Python render; message thread only
     juce::Synthesiser mSampler;
     const int mNumVoices{ 128 };
 
     void saveSound(const juce::File& file);
-    juce::File loadFileSound(const juce::File& file);
+    bool loadFileSound(const juce::File& file);     // replaces mainbuffer and the sampler sound
     juce::AudioBuffer<float>* getLiveBuffer() { return liveViewBuffer.get(); }  // For live buffer view
     juce::AudioVisualiserComponent waveviewer;
 private:
 
     juce::AudioFormatManager mFormatManager;
-    juce::AudioFormatReader* mFormatReader{ nullptr };
 
-    std::unique_ptr<Pyembedder> pyEmbedder;
+   #if IMAGINE_ENABLE_PYTHON
+    // Shared with every other instance; started on the first Python render
+    juce::SharedResourcePointer<PythonRuntime> python;
+    // The path main_generation_handler returned, releasing pValue. Called on the
+    // generation thread, so the result goes back in GenerationResult, not outputpath.
+    static juce::File takeGeneratedPath(PyObject* pValue);
+   #endif
+
+    // Copies host automation of legacyDuration into duration
+    class LegacyDurationMapping;
+    std::unique_ptr<LegacyDurationMapping> legacyDurationMapping;
 
 
     //==============================================================================
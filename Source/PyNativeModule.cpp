@@ -0,0 +1,383 @@
+/*
+  ==============================================================================
+
+    PyNativeModule.cpp
+    Created: 18 Oct 2026 6:47:11am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#include "PyNativeModule.h"
+
+#if IMAGINE_ENABLE_PYTHON
+#include "ImageFeatures.h"
+#include "ImageLoader.h"
+#include <stdexcept>
+
+#ifdef _DEBUG
+#undef _DEBUG
+#include <python.h>
+#define _DEBUG
+#else
+#include <python.h>
+#endif
+
+//==============================================================================
+// A strided view onto memory owned by C++, exported through the buffer protocol.
+// The owner keeps the memory (a juce::Image, an AudioBuffer, ImageFeatures) alive.
+struct NativeBufferObject
+{
+    PyObject_HEAD
+    std::shared_ptr<void>* owner;
+    void* data;
+    int ndim;
+    Py_ssize_t shape[3];
+    Py_ssize_t strides[3];
+    Py_ssize_t itemSize;
+    const char* format;
+    bool readOnly;
+};
+
+static int nativeBufferGetBuffer(PyObject* self, Py_buffer* view, int flags)
+{
+    auto* buffer = reinterpret_cast<NativeBufferObject*>(self);
+
+    if ((flags & PyBUF_WRITABLE) == PyBUF_WRITABLE && buffer->readOnly)
+    {
+        PyErr_SetString(PyExc_BufferError, "Buffer is read-only");
+        return -1;
+    }
+
+    Py_ssize_t length = buffer->itemSize;
+    for (int i = 0; i < buffer->ndim; ++i)
+        length *= buffer->shape[i];
+
+    // Only 1-D audio is contiguous; pixel views need a strides-aware consumer
+    if ((flags & PyBUF_STRIDES) != PyBUF_STRIDES && (buffer->ndim != 1 || buffer->strides[0] != buffer->itemSize))
+    {
+        PyErr_SetString(PyExc_BufferError, "Buffer is not contiguous");
+        return -1;
+    }
+
+    view->obj = self;
+    Py_INCREF(self);
+    view->buf = buffer->data;
+    view->len = length;
+    view->readonly = buffer->readOnly ? 1 : 0;
+    view->itemsize = buffer->itemSize;
+    view->format = (flags & PyBUF_FORMAT) == PyBUF_FORMAT ? const_cast<char*>(buffer->format) : nullptr;
+    view->ndim = buffer->ndim;
+    view->shape = (flags & PyBUF_ND) == PyBUF_ND ? buffer->shape : nullptr;
+    view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? buffer->strides : nullptr;
+    view->suboffsets = nullptr;
+    view->internal = nullptr;
+    return 0;
+}
+
+static void nativeBufferDealloc(PyObject* self)
+{
+    delete reinterpret_cast<NativeBufferObject*>(self)->owner;
+    PyObject_Free(self);
+}
+
+static PyBufferProcs nativeBufferProcs = { nativeBufferGetBuffer, nullptr };
+static PyTypeObject nativeBufferType = { PyVarObject_HEAD_INIT(nullptr, 0) };
+
+static bool prepareBufferType()
+{
+    if ((nativeBufferType.tp_flags & Py_TPFLAGS_READY) != 0)
+        return true;
+
+    nativeBufferType.tp_name = "imagine_native.Buffer";
+    nativeBufferType.tp_basicsize = sizeof(NativeBufferObject);
+    nativeBufferType.tp_flags = Py_TPFLAGS_DEFAULT;
+    nativeBufferType.tp_doc = "Pixels or samples owned by the plugin, exposed without copying.";
+    nativeBufferType.tp_dealloc = nativeBufferDealloc;
+    nativeBufferType.tp_as_buffer = &nativeBufferProcs;
+
+    return PyType_Ready(&nativeBufferType) == 0;
+}
+
+static NativeBufferObject* newNativeBuffer(std::shared_ptr<void> owner)
+{
+    if (!prepareBufferType())
+        return nullptr;
+
+    auto* buffer = PyObject_New(NativeBufferObject, &nativeBufferType);
+    if (buffer == nullptr)
+        return nullptr;
+
+    buffer->owner = new std::shared_ptr<void>(std::move(owner));
+    buffer->data = nullptr;
+    buffer->ndim = 0;
+    buffer->itemSize = 1;
+    buffer->format = "B";
+    buffer->readOnly = true;
+    return buffer;
+}
+
+namespace
+{
+    // Keeps the image's pixel data mapped for the lifetime of the Python object
+    struct PixelHolder
+    {
+        explicit PixelHolder(const juce::Image& source)
+            : image(source), bitmap(image, juce::Image::BitmapData::readOnly)
+        {
+        }
+
+        juce::Image image;
+        juce::Image::BitmapData bitmap;
+    };
+
+    // ARGB is premultiplied. PIL's convert('RGB') keeps the stored colour and
+    // drops alpha, and so does ImageLoader::fromImage, so unpremultiply here
+    // rather than flattening over black.
+    juce::Image dropAlpha(const juce::Image& source)
+    {
+        juce::Image rgb(juce::Image::RGB, source.getWidth(), source.getHeight(), false);
+
+        const juce::Image::BitmapData in(source, juce::Image::BitmapData::readOnly);
+        juce::Image::BitmapData out(rgb, juce::Image::BitmapData::writeOnly);
+
+        for (int y = 0; y < in.height; ++y)
+        {
+            for (int x = 0; x < in.width; ++x)
+            {
+                auto argb = *reinterpret_cast<const juce::PixelARGB*>(in.getPixelPointer(x, y));
+                argb.unpremultiply();
+                reinterpret_cast<juce::PixelRGB*>(out.getPixelPointer(x, y))->set(argb);
+            }
+        }
+
+        return rgb;
+    }
+}
+
+PyObject* createPixelBuffer(const juce::Image& source)
+{
+    if (!source.isValid())
+    {
+        PyErr_SetString(PyExc_ValueError, "Image cannot be null");
+        return nullptr;
+    }
+
+    // Converted once rather than exposing 4 channels
+    juce::Image image = source.getFormat() == juce::Image::ARGB ? dropAlpha(source) : source;
+
+    auto holder = std::make_shared<PixelHolder>(image);
+    auto& bitmap = holder->bitmap;
+
+    NativeBufferObject* buffer = newNativeBuffer(holder);
+    if (buffer == nullptr)
+        return nullptr;
+
+    buffer->ndim = 3;
+    buffer->shape[0] = bitmap.height;
+    buffer->shape[1] = bitmap.width;
+    buffer->shape[2] = 3;
+    buffer->strides[0] = bitmap.lineStride;
+    buffer->strides[1] = bitmap.pixelStride;
+
+    if (image.getFormat() == juce::Image::SingleChannel)
+    {
+        // Grey: the same byte three times, like PIL's convert('RGB')
+        buffer->data = bitmap.data;
+        buffer->strides[2] = 0;
+    }
+    else
+    {
+        // In-memory byte order is platform dependent, so walk R -> G -> B with
+        // a signed channel stride
+        buffer->data = bitmap.data + juce::PixelRGB::indexR;
+        buffer->strides[2] = juce::PixelRGB::indexG - juce::PixelRGB::indexR;
+    }
+
+    return reinterpret_cast<PyObject*>(buffer);
+}
+
+PyObject* createAudioBuffer(std::shared_ptr<juce::AudioBuffer<float>> audio, int channel)
+{
+    if (audio == nullptr || !juce::isPositiveAndBelow(channel, audio->getNumChannels()))
+    {
+        PyErr_SetString(PyExc_ValueError, "Invalid audio buffer");
+        return nullptr;
+    }
+
+    float* samples = audio->getWritePointer(channel);
+    const int numSamples = audio->getNumSamples();
+
+    NativeBufferObject* buffer = newNativeBuffer(std::move(audio));
+    if (buffer == nullptr)
+        return nullptr;
+
+    buffer->data = samples;
+    buffer->ndim = 1;
+    buffer->shape[0] = numSamples;
+    buffer->strides[0] = (Py_ssize_t)sizeof(float);
+    buffer->itemSize = (Py_ssize_t)sizeof(float);
+    buffer->format = "f";
+    buffer->readOnly = false;
+    return reinterpret_cast<PyObject*>(buffer);
+}
+
+//==============================================================================
+// A read-only 1-D float32 view of one feature array, as a memoryview so that
+// len(), indexing and iteration work as they did on the lists image_convolution builds
+static PyObject* createFeatureArray(const std::shared_ptr<const ImageFeatures>& features, const std::vector<float>& values)
+{
+    NativeBufferObject* buffer = newNativeBuffer(std::const_pointer_cast<ImageFeatures>(features));
+    if (buffer == nullptr)
+        return nullptr;
+
+    buffer->data = const_cast<float*>(values.data());
+    buffer->ndim = 1;
+    buffer->shape[0] = (Py_ssize_t)values.size();
+    buffer->strides[0] = (Py_ssize_t)sizeof(float);
+    buffer->itemSize = (Py_ssize_t)sizeof(float);
+    buffer->format = "f";
+
+    PyObject* view = PyMemoryView_FromObject(reinterpret_cast<PyObject*>(buffer));
+    Py_DECREF(buffer);
+    return view;
+}
+
+PyObject* createFeatureDict(std::shared_ptr<const ImageFeatures> features)
+{
+    if (features == nullptr)
+    {
+        PyErr_SetString(PyExc_ValueError, "Features cannot be null");
+        return nullptr;
+    }
+
+    PyObject* result = PyDict_New();
+    if (result == nullptr)
+        return nullptr;
+
+    std::vector<std::pair<const char*, const std::vector<float>*>> keys = {
+        { "1", &features->red }, { "2", &features->green }, { "3", &features->blue }
+    };
+
+    if (features->hasExtended())
+    {
+        keys.push_back({ "saturation", &features->extended[(size_t)ExtendedFeature::saturation] });
+        keys.push_back({ "value", &features->extended[(size_t)ExtendedFeature::value] });
+        keys.push_back({ "luminance_variance", &features->extended[(size_t)ExtendedFeature::luminanceVariance] });
+        keys.push_back({ "edge_density", &features->extended[(size_t)ExtendedFeature::edgeDensity] });
+    }
+
+    for (const auto& [key, values] : keys)
+    {
+        PyObject* array = createFeatureArray(features, *values);
+        if (array == nullptr || PyDict_SetItemString(result, key, array) != 0)
+        {
+            Py_XDECREF(array);
+            Py_DECREF(result);
+            return nullptr;
+        }
+        Py_DECREF(array);
+    }
+
+    return result;
+}
+
+static PyObject* blockMeans(PyObject* /*self*/, PyObject* args)
+{
+    PyObject* image = nullptr;
+    int kernelSize = 0, stepSize = 0;
+
+    if (!PyArg_ParseTuple(args, "Oii", &image, &kernelSize, &stepSize))
+        return nullptr;
+
+    Py_buffer view;
+    if (PyObject_GetBuffer(image, &view, PyBUF_STRIDES | PyBUF_FORMAT) != 0)
+        return nullptr;
+
+    if (view.ndim != 3 || view.itemsize != 1 || view.shape[2] < 3
+        || view.strides[0] <= 0 || view.strides[1] <= 0)
+    {
+        PyBuffer_Release(&view);
+        PyErr_SetString(PyExc_ValueError, "Image must be an HxWx3 uint8 array");
+        return nullptr;
+    }
+
+    const int height = (int)view.shape[0];
+    const int width = (int)view.shape[1];
+    const auto* base = static_cast<const uint8_t*>(view.buf);
+
+    std::array<ChannelView, 3> channels;
+    for (int c = 0; c < 3; ++c)
+        channels[c] = { base + c * view.strides[2], (int)view.strides[1], (int)view.strides[0] };
+
+    auto features = std::make_shared<ImageFeatures>();
+    std::string error;
+
+    // The buffer stays valid while we hold the view, so the GIL can go
+    Py_BEGIN_ALLOW_THREADS
+    try
+    {
+        IntegralImage integral;
+        integral.build(channels, width, height);
+        *features = integral.computeBlockMeans(kernelSize, stepSize);
+    }
+    catch (const std::exception& e)
+    {
+        error = e.what();
+    }
+    Py_END_ALLOW_THREADS
+
+    PyBuffer_Release(&view);
+
+    if (!error.empty())
+    {
+        PyErr_SetString(PyExc_ValueError, error.c_str());
+        return nullptr;
+    }
+
+    return createFeatureDict(std::move(features));
+}
+
+static PyObject* loadImage(PyObject* /*self*/, PyObject* args)
+{
+    const char* path = nullptr;
+    if (!PyArg_ParseTuple(args, "s", &path))
+        return nullptr;
+
+    const juce::File file(juce::String::fromUTF8(path));
+    juce::Image image;
+
+    Py_BEGIN_ALLOW_THREADS
+    image = ImageLoader::decodeWithSizeLimit(file);
+    Py_END_ALLOW_THREADS
+
+    if (!image.isValid())
+        Py_RETURN_NONE;
+
+    return createPixelBuffer(image);
+}
+
+static PyMethodDef nativeMethods[] = {
+    { "block_means", blockMeans, METH_VARARGS, "Per-window RGB means from a summed-area table." },
+    { "load_image", loadImage, METH_VARARGS, "Decode an image into an HxWx3 uint8 buffer." },
+    { nullptr, nullptr, 0, nullptr }
+};
+
+static PyModuleDef nativeModule = {
+    PyModuleDef_HEAD_INIT, "imagine_native", "Native helpers for the Imagine generator.", -1, nativeMethods
+};
+
+static PyObject* initNativeModule()
+{
+    if (!prepareBufferType())
+        return nullptr;
+
+    return PyModule_Create(&nativeModule);
+}
+
+void registerNativeModule()
+{
+    PyImport_AppendInittab("imagine_native", &initNativeModule);
+}
+
+#endif
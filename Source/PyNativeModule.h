@@ -0,0 +1,58 @@
+/*
+  ==============================================================================
+
+    PyNativeModule.h
+    Created: 18 Oct 2026 6:47:11am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "PythonConfig.h"
+#include <memory>
+
+#if IMAGINE_ENABLE_PYTHON
+
+struct ImageFeatures;
+typedef struct _object PyObject;
+
+namespace juce
+{
+    class Image;
+    template <typename Type> class AudioBuffer;
+}
+
+// Registers the built-in "imagine_native" module with the embedded interpreter.
+// Must be called before Py_Initialize().
+//
+// imagine_native.block_means(image, kernel_size, step_size)
+//     image is any HxWx3 (or HxWx4) uint8 buffer, e.g. a numpy array.
+//     Returns the same {'1': ..., '2': ..., '3': ...} dict that
+//     image_convolution builds, computed from a summed-area table in C++,
+//     with float32 buffers in place of the lists.
+//
+// imagine_native.load_image(path)
+//     Decodes a jpg/png with JUCE (same size limit as the PIL path) and returns
+//     it as a pixel buffer, or None if it can't be decoded.
+void registerNativeModule();
+
+// Builds the {'1': ..., '2': ..., '3': ...} dict generate_sound expects, plus
+// 'saturation', 'value', 'luminance_variance' and 'edge_density' when the
+// features have them. Each value is a read-only 1-D float32 memoryview onto the
+// features, which stay alive for as long as Python holds any of them.
+// Requires the GIL; returns a new reference or nullptr with a Python error set.
+PyObject* createFeatureDict(std::shared_ptr<const ImageFeatures> features);
+
+// Exposes an image's pixels to Python as a read-only HxWx3 uint8 buffer in
+// R, G, B order, without copying. np.asarray() on the result is a view; the
+// pixels stay alive for as long as Python holds a reference.
+// Requires the GIL; returns a new reference or nullptr with a Python error set.
+PyObject* createPixelBuffer(const juce::Image& image);
+
+// Exposes one channel of an AudioBuffer to Python as a writable 1-D float32
+// buffer, so the generator can render straight into it.
+// Requires the GIL; returns a new reference or nullptr with a Python error set.
+PyObject* createAudioBuffer(std::shared_ptr<juce::AudioBuffer<float>> buffer, int channel);
+
+#endif
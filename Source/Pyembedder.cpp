@@ -24,6 +24,11 @@ import math
 import scipy
 from scipy.signal import butter, lfilter
 
+try:
+    import imagine_native
+except ImportError:
+    imagine_native = None
+
 
 
 def image_convolution(image, kernel_size, step_size):
@@ -61,6 +66,10 @@ def image_convolution(image, kernel_size, step_size):
     if kernel_size > x or kernel_size > y:
         raise ValueError('Kernel size cannot be larger than the image')
 
+    # Summed-area table in C++ when running inside the plugin
+    if imagine_native is not None:
+        return imagine_native.block_means(np.asarray(image, dtype=np.uint8), kernel_size, step_size)
+
     red_values = image[:, :, 0]
     green_values = image[:, :, 1]
     blue_values = image[:, :, 2]
@@ -159,7 +168,8 @@ def generate_sound(
     lfo_scalar_amplitude=1,
     lfo_intensity=1,
     overtone_num_scalar=1,
-    lfo_amount_scalar=1
+    lfo_amount_scalar=1,
+    audio_out=None
 ):
     """
     Generate a sound based on the given RGB values.
@@ -190,10 +200,14 @@ def generate_sound(
         The amplitude scaling factor for the LFO. Default is 1.
     lfo_intensity : float, optional
         The intensity of the LFO, from 0 (no LFO) to 1 (maximum LFO). Default is 1.
+    audio_out : buffer, optional
+        A writable float32 buffer to render into instead of writing a WAV file.
 
     Returns
     -------
-    None
+    str or (str, int)
+        The path of the written WAV file, or the dominant color and the number
+        of samples written when audio_out is given.
     """
     if rgb_dict is None:
         raise ValueError('rgb_dict cannot be null')
@@ -243,6 +257,14 @@ def generate_sound(
     final_sound = apply_limiter(final_sound, threshold=0.8)
     final_sound = lowpass_filter(final_sound, cutoff=5000, sample_rate=sample_rate)
     final_sound = final_sound *     sound_level
+
+    # Render straight into the plugin's buffer, no WAV round trip
+    if audio_out is not None:
+        out = np.asarray(audio_out)
+        n = min(len(out), len(final_sound))
+        out[:n] = final_sound[:n]
+        return dominant_color, n
+
     final_sound = (final_sound * 32767).astype(np.int16)
 
     
@@ -772,6 +794,31 @@ def modify_base_tone(sound, color_average, overtone_type,base_freq, time, interp
 #
 )";
 Pythoncode11 = R"(
+def load_image_array(path):
+    """
+    Load an image as an HxWx3 uint8 array, resized to 3840x2160 if it is larger.
+
+    Uses imagine_native when available, in which case the array is a view onto
+    the pixels the plugin decoded rather than a copy.
+    """
+    if imagine_native is not None:
+        pixels = imagine_native.load_image(path)
+        if pixels is not None:
+            return np.asarray(pixels)
+
+    img = Image.open(path)
+    img = img.convert('RGB')
+    img_array = np.asarray(img)
+
+    #check if image dimensions are greater than 3840*2160
+    if img_array.shape[0] > 3840 or img_array.shape[1] > 2160:
+        print("Error: Image dimensions are greater than 3840*2160, resizing to 3840*2160")
+        img = img.resize((3840, 2160))
+        img_array = np.asarray(img)
+
+    return img_array
+
+
 def main_generation_handler(
         img_path: str,
         out_path: str,
@@ -837,17 +884,7 @@ def main_generation_handler(
             file_name = os.path.splitext(os.path.basename(file))[0]
             print("Processing image: "+file_name)
             file_names.append(file_name)
-            img = Image.open(file)
-            img = img.convert('RGB')
-            img_array = np.asarray(img)
-            
-            #check if image dimensions are greater than 3840*2160
-            if img_array.shape[0] > 3840 or img_array.shape[1] > 2160:
-                print("Error: Image dimensions are greater than 3840*2160, resizing to 3840*2160")
-                img = img.resize((3840, 2160))
-                img_array = np.asarray(img)
-
-            images.append(img_array)
+            images.append(load_image_array(file))
 
         print("Convolving image batch...")
         for n in range(len(images)):
@@ -874,15 +911,7 @@ def main_generation_handler(
             print("Audio generated for: "+file_names[n])
 
     else:
-        image = Image.open(img_path)
-        image = image.convert('RGB')
-        image_array = np.asarray(image)
-
-        #check if image dimensions are greater than 3840*2160
-        if image_array.shape[0] > 3840 or image_array.shape[1] > 2160:
-            print("Error: Image dimensions are greater than 3840*2160, resizing to 3840*2160")
-            image = image.resize((3840, 2160))
-            image_array = np.asarray(image)
+        image_array = load_image_array(img_path)
         file_name = os.path.splitext(os.path.basename(img_path))[0]
         print("Convolving image: "+file_name)
         rgb_dict = image_convolution(image_array, kernel_size, step_size)
@@ -0,0 +1,19 @@
+/*
+  ==============================================================================
+
+    PythonConfig.h
+    Created: 18 Oct 2026 9:41:12am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Set IMAGINE_ENABLE_PYTHON=0 in the Projucer's preprocessor definitions to
+// build without the embedded Python generator. Nothing then includes
+// Python.h, so the plugin neither links against nor loads python313.dll and
+// runs on machines without Python; every generation uses the native engine.
+#ifndef IMAGINE_ENABLE_PYTHON
+ #define IMAGINE_ENABLE_PYTHON 1
+#endif
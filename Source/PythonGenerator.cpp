@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    PythonGenerator.cpp
+    Created: 18 Oct 2026 6:52:23am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#include "PythonGenerator.h"
+
+#if IMAGINE_ENABLE_PYTHON
+
+PythonGenerator::PythonGenerator(std::string sourceCode)
+    : source(std::move(sourceCode))
+{
+}
+
+PythonGenerator::~PythonGenerator()
+{
+    {
+        const std::lock_guard<std::mutex> lock(threadLock);
+        if (warmUpThread.joinable())
+            warmUpThread.join();
+    }
+
+    ScopedGIL gil;
+    Py_XDECREF(generateSound);
+    Py_XDECREF(mainGenerationHandler);
+    Py_XDECREF(module);
+}
+
+void PythonGenerator::startWarmUp()
+{
+    const std::lock_guard<std::mutex> lock(threadLock);
+
+    if (compiled || warmUpThread.joinable())
+        return;
+
+    warmUpThread = std::thread([this]
+        {
+            ScopedGIL gil;
+            compile();
+        });
+}
+
+bool PythonGenerator::compile()
+{
+    // Whoever is compiling (the warm-up thread, say) needs the GIL to finish,
+    // so let go of it while waiting for the lock
+    std::unique_lock<std::mutex> lock(compileLock, std::defer_lock);
+
+    Py_BEGIN_ALLOW_THREADS
+    lock.lock();
+    Py_END_ALLOW_THREADS
+
+    if (compiled)
+        return mainGenerationHandler != nullptr && generateSound != nullptr;
+
+    compiled = true;
+
+    PyObject* code = Py_CompileString(source.c_str(), moduleName, Py_file_input);
+    if (code == nullptr)
+    {
+        PyErr_Print();
+        return false;
+    }
+
+    // Executing the module body runs the numpy/scipy/PIL imports once
+    module = PyImport_ExecCodeModule(moduleName, code);
+    Py_DECREF(code);
+
+    if (module == nullptr)
+    {
+        PyErr_Print();
+        return false;
+    }
+
+    mainGenerationHandler = PyObject_GetAttrString(module, "main_generation_handler");
+    generateSound = PyObject_GetAttrString(module, "generate_sound");
+
+    if (PyErr_Occurred())
+        PyErr_Print();
+
+    return mainGenerationHandler != nullptr && generateSound != nullptr;
+}
+
+PyObject* PythonGenerator::getMainGenerationHandler()
+{
+    return compile() ? mainGenerationHandler : nullptr;
+}
+
+PyObject* PythonGenerator::getGenerateSound()
+{
+    return compile() ? generateSound : nullptr;
+}
+
+#endif
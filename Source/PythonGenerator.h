@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    PythonGenerator.h
+    Created: 18 Oct 2026 6:52:23am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "PythonConfig.h"
+
+#if IMAGINE_ENABLE_PYTHON
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#ifdef _DEBUG
+#undef _DEBUG
+#include <python.h>
+#define _DEBUG
+#else
+#include <python.h>
+#endif
+
+// Holds the GIL for the lifetime of the object. Safe from any thread once
+// the interpreter is initialised.
+struct ScopedGIL
+{
+    ScopedGIL() : state(PyGILState_Ensure()) {}
+    ~ScopedGIL() { PyGILState_Release(state); }
+
+    ScopedGIL(const ScopedGIL&) = delete;
+    ScopedGIL& operator= (const ScopedGIL&) = delete;
+
+    PyGILState_STATE state;
+};
+
+//==============================================================================
+/**
+    The embedded generator (Pyembedder::Pythoncode1..11) compiled once into its
+    own "imagine_generator" module, with cached handles to its entry points.
+
+    startWarmUp() compiles the module on a background thread so the cold
+    import of numpy, scipy.signal and PIL is paid before the first Generate.
+    The caller must not hold the GIL when constructing, starting the warm-up
+    or destroying this object. Any number of threads may ask for the entry
+    points at once; the first compiles and the rest wait for it.
+*/
+class PythonGenerator
+{
+public:
+    explicit PythonGenerator(std::string sourceCode);
+    ~PythonGenerator();
+
+    void startWarmUp();
+
+    // Require the GIL. Wait for the warm-up (or compile on first use) and
+    // return borrowed references, or nullptr with a Python error printed.
+    // The GIL is let go while waiting.
+    PyObject* getMainGenerationHandler();
+    PyObject* getGenerateSound();
+
+    static constexpr const char* moduleName = "imagine_generator";
+
+private:
+    bool compile();     // requires the GIL
+
+    std::string source;
+
+    std::mutex threadLock;          // guards warmUpThread
+    std::thread warmUpThread;
+
+    // Importing the module releases the GIL from time to time, so the GIL
+    // alone can't keep a second caller out of compile()
+    std::mutex compileLock;
+    std::atomic<bool> compiled{ false };
+
+    PyObject* module = nullptr;
+    PyObject* mainGenerationHandler = nullptr;
+    PyObject* generateSound = nullptr;
+};
+
+#endif
@@ -0,0 +1,133 @@
+/*
+  ==============================================================================
+
+    PythonRuntime.cpp
+    Created: 18 Oct 2026 7:17:07am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#include "PythonRuntime.h"
+
+#if IMAGINE_ENABLE_PYTHON
+#include "Pyembedder.h"
+#include "PyNativeModule.h"
+#include <chrono>
+#include <future>
+
+#if JUCE_WINDOWS
+ #ifndef NOMINMAX
+  #define NOMINMAX
+ #endif
+ #include <windows.h>
+#else
+ #include <dlfcn.h>
+#endif
+
+namespace
+{
+    // The interpreter thread below runs code from this binary, and the interpreter keeps
+    // pointers to the imagine_native functions and buffer type. Neither can be taken back
+    // short of Py_Finalize (see PythonRuntime), so the binary is pinned: it stays loaded
+    // until the process exits, even after the host has unloaded the plugin.
+    void pinThisModule()
+    {
+       #if JUCE_WINDOWS
+        HMODULE module = nullptr;
+        if (!GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_PIN,
+                                reinterpret_cast<LPCWSTR>(&pinThisModule), &module))
+            DBG("Could not pin the plugin binary: error " << (int)GetLastError());
+       #else
+        // The handle is never closed; with RTLD_NODELETE it couldn't unload it anyway
+        Dl_info info;
+        if (dladdr(reinterpret_cast<void*>(&pinThisModule), &info) == 0 || info.dli_fname == nullptr
+            || dlopen(info.dli_fname, RTLD_NOW | RTLD_NOLOAD | RTLD_NODELETE) == nullptr)
+            DBG("Could not pin the plugin binary");
+       #endif
+    }
+
+    // Once per process, however many runtimes come and go. The interpreter's
+    // main thread state belongs to the thread that initialises it, so that is
+    // done on a thread of its own that lives as long as the process, rather
+    // than on whichever (possibly short-lived) thread asked first.
+    bool startInterpreter()
+    {
+        static const bool started = []
+        {
+            if (Py_IsInitialized())
+                return true;
+
+            pinThisModule();
+
+            std::promise<bool> initialised;
+            auto result = initialised.get_future();
+
+            std::thread([initialised = std::move(initialised)]() mutable
+                {
+                    registerNativeModule();
+                    Py_Initialize();
+
+                    // Hand the GIL back; every call takes it with ScopedGIL
+                    if (Py_IsInitialized())
+                        PyEval_SaveThread();
+
+                    initialised.set_value(Py_IsInitialized() != 0);
+
+                    for (;;)
+                        std::this_thread::sleep_for(std::chrono::hours(24));
+                }).detach();
+
+            return result.get();
+        }();
+
+        return started;
+    }
+}
+
+PythonRuntime::~PythonRuntime()
+{
+    if (warmUpThread.joinable())
+        warmUpThread.join();
+
+    generator.reset();
+}
+
+PythonGenerator* PythonRuntime::getGenerator()
+{
+    const juce::ScopedLock sl(lock);
+
+    if (generator == nullptr && startInterpreter())
+    {
+        Pyembedder embedder;
+        generator = std::make_unique<PythonGenerator>(embedder.Pythoncode1 +
+            embedder.Pythoncode2 +
+            embedder.Pythoncode3 +
+            embedder.Pythoncode4 +
+            embedder.Pythoncode5 +
+            embedder.Pythoncode6 +
+            embedder.Pythoncode7 +
+            embedder.Pythoncode8 +
+            embedder.Pythoncode9 +
+            embedder.Pythoncode10 +
+            embedder.Pythoncode11);
+    }
+
+    return generator.get();
+}
+
+void PythonRuntime::warmUp()
+{
+    const juce::ScopedLock sl(lock);
+
+    if (generator != nullptr || warmUpThread.joinable())
+        return;
+
+    warmUpThread = std::thread([this]
+        {
+            if (auto* g = getGenerator())
+                g->startWarmUp();
+        });
+}
+
+#endif
@@ -0,0 +1,64 @@
+/*
+  ==============================================================================
+
+    PythonRuntime.h
+    Created: 18 Oct 2026 7:17:07am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "PythonGenerator.h"
+
+#if IMAGINE_ENABLE_PYTHON
+#include <memory>
+#include <thread>
+
+//==============================================================================
+/**
+    The embedded interpreter and generator, shared by every plugin instance in
+    the process. Hold it through a juce::SharedResourcePointer<PythonRuntime>.
+
+    Nothing is started until a generation first asks for the generator, so
+    constructing a plugin (as hosts do when scanning, and for every track)
+    never touches Python. getGenerator() and warmUp() may be called from any
+    thread, without the GIL.
+
+    The interpreter is started on a thread of its own, which then sleeps
+    until the process exits, so its main thread state never belongs to a
+    thread that has gone. The generator is released with the last instance,
+    but the interpreter is never finalised: numpy can't be imported again after Py_Finalize, so a
+    later instance in the same process would fail. Once started it stays up
+    until the process exits.
+
+    That thread can't be joined without finalising, so starting the
+    interpreter pins the plugin binary instead (GetModuleHandleEx with
+    GET_MODULE_HANDLE_EX_FLAG_PIN, or dlopen with RTLD_NODELETE). A host that
+    unloads the plugin leaves it mapped, and the sleeping thread never wakes
+    in unmapped code.
+*/
+class PythonRuntime
+{
+public:
+    PythonRuntime() = default;
+    ~PythonRuntime();
+
+    // Starts the interpreter if needed and returns the compiled generator, or
+    // null if the interpreter couldn't be started. Call without holding the GIL.
+    PythonGenerator* getGenerator();
+
+    // Starts the interpreter and imports the generator's modules on a
+    // background thread, for when a Python render is likely soon. Returns at once.
+    void warmUp();
+
+private:
+    juce::CriticalSection lock;
+    std::unique_ptr<PythonGenerator> generator;
+    std::thread warmUpThread;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PythonRuntime)
+};
+
+#endif
@@ -0,0 +1,379 @@
+/*
+  ==============================================================================
+
+    SequenceRenderer.cpp
+    Created: 18 Oct 2026 7:31:36am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#include "SequenceRenderer.h"
+#include "BoundedQueue.h"
+#include "ExtendedFeatures.h"
+#include "ImageFeatures.h"
+#include "ImageLoader.h"
+#include "ParallelFor.h"
+#include "TiledImageReader.h"
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+namespace
+{
+    // One frame from the decode thread: a PlanarImage, or block means already
+    // read by TiledImageReader for frames too large to decode. Both empty if
+    // the file couldn't be read.
+    struct DecodedFrame
+    {
+        int index = 0;
+        PlanarImage image;
+        ImageFeatures oversized;
+    };
+
+    //==============================================================================
+    // Block means for consecutive frames, recomputing only the tiles of windows
+    // whose pixels changed since the frame before
+    class IncrementalFeatures
+    {
+    public:
+        IncrementalFeatures(int kernel, int step, TraversalOrder traversal, int tile)
+            : kernelSize(kernel), stepSize(step), order(traversal), tileWindows(juce::jmax(1, tile))
+        {
+        }
+
+        // Throws std::invalid_argument like IntegralImage::computeBlockMeans when the
+        // kernel doesn't fit; the previous frame's features are kept in that case
+        void update(PlanarImage image, bool incremental, SequenceRenderer::Report& report)
+        {
+            const int scale = juce::jmax(1, image.scale);
+            const int kernel = kernelSize / scale;
+            const int step = stepSize / scale;
+
+            const bool sameGrid = incremental && !features.isEmpty() && !previous.isEmpty()
+                               && image.width == previous.width && image.height == previous.height && image.scale == previous.scale;
+
+            if (!sameGrid)
+            {
+                IntegralImage integral;
+                integral.build(image);
+                features = integral.computeBlockMeans(kernelSize, stepSize, order);
+
+                numRows = (image.height - kernel) / step + 1;
+                numCols = (image.width - kernel) / step + 1;
+                ranks = incremental ? WindowTraversal::computeRanks(order, numRows, numCols) : std::vector<int>();
+
+                const juce::int64 numTiles = (juce::int64)getNumTileRows() * getNumTileCols();
+                report.tilesRecomputed += numTiles;
+                report.tilesTotal += numTiles;
+            }
+            else
+            {
+                report.tilesRecomputed += recomputeChangedTiles(image, kernel, step);
+                report.tilesTotal += (juce::int64)getNumTileRows() * getNumTileCols();
+            }
+
+            // Only kept when the next frame will be compared against it
+            previous = incremental ? std::move(image) : PlanarImage();
+        }
+
+        // Features that were computed elsewhere; the next frame starts over
+        void set(ImageFeatures newFeatures)
+        {
+            features = std::move(newFeatures);
+            previous = {};
+        }
+
+        const ImageFeatures& getFeatures() const { return features; }
+
+    private:
+        int getNumTileRows() const { return (numRows + tileWindows - 1) / tileWindows; }
+        int getNumTileCols() const { return (numCols + tileWindows - 1) / tileWindows; }
+
+        // True if any sample in [x0, x1) x [y0, y1) differs from the previous frame
+        bool differs(const PlanarImage& image, int x0, int x1, int y0, int y1) const
+        {
+            const size_t rowBytes = (size_t)(x1 - x0) * sizeof(uint16_t);
+
+            for (size_t c = 0; c < 3; ++c)
+            {
+                for (int y = y0; y < y1; ++y)
+                {
+                    const size_t offset = (size_t)y * (size_t)image.width + (size_t)x0;
+
+                    if (std::memcmp(image.planes[c].data() + offset, previous.planes[c].data() + offset, rowBytes) != 0)
+                        return true;
+                }
+            }
+
+            return false;
+        }
+
+        int recomputeChangedTiles(const PlanarImage& image, int kernel, int step)
+        {
+            const int tileCols = getNumTileCols();
+            const int numTiles = getNumTileRows() * tileCols;
+            const double windowArea = (double)kernelSize * (double)kernelSize;
+
+            std::array<float*, 3> outputs{ features.red.data(), features.green.data(), features.blue.data() };
+            std::atomic<int> recomputed{ 0 };
+
+            parallelFor(0, numTiles, 4, [&](int begin, int end)
+                {
+                    std::vector<juce::uint64> columnSums;
+
+                    for (int tile = begin; tile < end; ++tile)
+                    {
+                        const int rowBegin = (tile / tileCols) * tileWindows;
+                        const int colBegin = (tile % tileCols) * tileWindows;
+                        const int rowEnd = juce::jmin(numRows, rowBegin + tileWindows);
+                        const int colEnd = juce::jmin(numCols, colBegin + tileWindows);
+
+                        // Every sample some window in the tile covers
+                        const int x0 = colBegin * step;
+                        const int x1 = (colEnd - 1) * step + kernel;
+
+                        if (!differs(image, x0, x1, rowBegin * step, (rowEnd - 1) * step + kernel))
+                            continue;
+
+                        ++recomputed;
+
+                        for (size_t c = 0; c < 3; ++c)
+                        {
+                            const uint16_t* plane = image.planes[c].data();
+
+                            for (int r = rowBegin; r < rowEnd; ++r)
+                            {
+                                // Column sums over the window row's kernel lines, then windows across them
+                                columnSums.assign((size_t)(x1 - x0), 0);
+
+                                for (int y = r * step; y < r * step + kernel; ++y)
+                                {
+                                    const uint16_t* row = plane + (size_t)y * (size_t)image.width + (size_t)x0;
+
+                                    for (int x = 0; x < x1 - x0; ++x)
+                                        columnSums[(size_t)x] += row[x];
+                                }
+
+                                for (int col = colBegin; col < colEnd; ++col)
+                                {
+                                    juce::uint64 sum = 0;
+                                    for (int x = col * step - x0; x < col * step - x0 + kernel; ++x)
+                                        sum += columnSums[(size_t)x];
+
+                                    // Same value and place IntegralImage::computeBlockMeans gives
+                                    outputs[c][(size_t)WindowTraversal::getRank(ranks, r, col, numCols)]
+                                        = (float)(((double)sum / windowArea + 0.000000000001) / 256.0);
+                                }
+                            }
+                        }
+                    }
+                });
+
+            return recomputed.load();
+        }
+
+        const int kernelSize, stepSize;
+        const TraversalOrder order;
+        const int tileWindows;
+        int numRows = 0, numCols = 0;
+        std::vector<int> ranks;         // empty in raster order
+        PlanarImage previous;
+        ImageFeatures features;
+    };
+
+    struct FileNameNaturalComparator
+    {
+        static int compareElements(const juce::File& a, const juce::File& b)
+        {
+            return a.getFileName().compareNatural(b.getFileName());
+        }
+    };
+}
+
+juce::Array<juce::File> SequenceRenderer::findFrames(const juce::File& folder)
+{
+    juce::Array<juce::File> frames;
+
+    for (const auto& file : folder.findChildFiles(juce::File::findFiles, false))
+        if (ImageLoader::isSupportedImage(file))
+            frames.add(file);
+
+    FileNameNaturalComparator comparator;
+    frames.sort(comparator);
+    return frames;
+}
+
+bool SequenceRenderer::render(const juce::Array<juce::File>& frames, const juce::File& outputFile,
+                              const GenerationParameters& params, const Options& options,
+                              Report* report, const ProgressCallback& onProgress)
+{
+    const double startTime = juce::Time::getMillisecondCounterHiRes();
+    const int total = frames.size();
+
+    Report localReport;
+    Report& result = report != nullptr ? *report : localReport;
+    result = {};
+
+    if (total == 0 || options.framesPerSecond <= 0.0 || params.sampleRate <= 0.0)
+        return false;
+
+    if (!outputFile.getParentDirectory().exists() && !outputFile.getParentDirectory().createDirectory())
+    {
+        DBG("Error: Failed to create directory: " << outputFile.getParentDirectory().getFullPathName());
+        return false;
+    }
+
+    // Same hidden name and final rename as BatchConverter::writeWavFile
+    const juce::File partial = outputFile.getSiblingFile("." + outputFile.getFileName() + ".part");
+    partial.deleteFile();
+
+    std::unique_ptr<juce::AudioFormatWriter> writer;
+    {
+        juce::WavAudioFormat wavFormat;
+        std::unique_ptr<juce::FileOutputStream> outputStream(partial.createOutputStream());
+        if (outputStream == nullptr)
+            return false;
+
+        writer.reset(wavFormat.createWriterFor(outputStream.get(), params.sampleRate, 1, 16, {}, 0));
+        if (writer == nullptr)
+        {
+            DBG("Error Creating WAV File Writer!");
+            outputStream.reset();
+            partial.deleteFile();
+            return false;
+        }
+
+        // The writer owns the stream from here on, and finishes the header when it goes
+        outputStream.release();
+    }
+
+    // Decoding the next frame overlaps with extracting and rendering this one
+    BoundedQueue<DecodedFrame> decoded(2);
+    std::atomic<bool> stopping{ false };
+
+    std::thread decoder([&]
+        {
+            for (int i = 0; i < total && !stopping; ++i)
+            {
+                DecodedFrame frame;
+                frame.index = i;
+
+                try
+                {
+                    if (TiledImageReader::shouldUse(frames.getReference(i)))
+                        frame.oversized = TiledImageReader::computeBlockMeans(frames.getReference(i), params.kernelSize, params.stepSize,
+                                                                              params.traversal);
+                    else
+                        frame.image = ImageLoader::load(frames.getReference(i), params.kernelSize, params.stepSize);
+                }
+                catch (const std::exception& e)
+                {
+                    juce::ignoreUnused(e);
+                    DBG("Frame decode failed: " << e.what());
+                }
+
+                if (!decoded.push(std::move(frame)))
+                    break;
+            }
+
+            decoded.close();
+        });
+
+    IncrementalFeatures extractor(params.kernelSize, params.stepSize, params.traversal, options.tileWindows);
+    ImageSynthEngine engine;
+    std::vector<float> block((size_t)ImageSynthEngine::defaultBlockSize);
+    const float* channels[] = { block.data() };
+
+    juce::int64 samplesWritten = 0;
+    bool haveFeatures = false;
+    bool ok = true;
+    DecodedFrame frame;
+
+    while (ok && decoded.pop(frame))
+    {
+        // Rounded frame ends, so the sequence doesn't drift from framesPerSecond
+        const auto frameEnd = (juce::int64)std::llround((double)(frame.index + 1) * params.sampleRate / options.framesPerSecond);
+        const juce::int64 numSamples = frameEnd - samplesWritten;
+
+        bool frameRead = false;
+
+        try
+        {
+            if (!frame.oversized.isEmpty())
+            {
+                extractor.set(std::move(frame.oversized));
+                frameRead = true;
+            }
+            else if (!frame.image.isEmpty() && params.needsExtendedFeatures())
+            {
+                // Tiles only track colour means, so mapped frames are extracted whole
+                extractor.set(ExtendedFeatureExtractor::compute(frame.image, params.kernelSize, params.stepSize, params.traversal));
+                frameRead = true;
+            }
+            else if (!frame.image.isEmpty())
+            {
+                extractor.update(std::move(frame.image), options.incremental, result);
+                frameRead = true;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            juce::ignoreUnused(e);
+            DBG("Frame feature extraction failed: " << e.what());
+        }
+
+        if (frameRead)
+            ++result.framesRendered;
+        else
+            ++result.framesFailed;
+
+        haveFeatures = haveFeatures || frameRead;
+
+        if (numSamples > 0)
+        {
+            if (haveFeatures && engine.prepareSegment(extractor.getFeatures().getChannels(), params, numSamples))
+            {
+                while (ok && !engine.isFinished())
+                {
+                    const int written = engine.renderNextBlock(block.data(), (int)block.size());
+                    if (written <= 0)
+                        break;
+
+                    ok = writer->writeFromFloatArrays(channels, 1, written);
+                }
+            }
+            else
+            {
+                // Nothing to render from yet: silence keeps later frames on time
+                juce::FloatVectorOperations::clear(block.data(), (int)block.size());
+
+                for (juce::int64 done = 0; ok && done < numSamples; done += (juce::int64)block.size())
+                    ok = writer->writeFromFloatArrays(channels, 1, (int)juce::jmin((juce::int64)block.size(), numSamples - done));
+            }
+
+            samplesWritten = frameEnd;
+        }
+
+        if (ok && onProgress != nullptr && !onProgress(frame.index + 1, total))
+            ok = false;
+    }
+
+    stopping = true;
+    decoded.close();
+    decoder.join();
+
+    // Finishes the header before the file is renamed
+    writer.reset();
+
+    result.seconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+
+    if (!ok || result.framesRendered == 0 || !partial.moveFileTo(outputFile))
+    {
+        partial.deleteFile();
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+    SequenceRenderer.h
+    Created: 18 Oct 2026 7:31:36am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "ImageSynthEngine.h"
+#include <functional>
+
+//==============================================================================
+/**
+    Turns a folder of numbered frames into one continuous WAV file.
+
+    Batch mode gives every image its own sound. Here each frame gets
+    1 / framesPerSecond seconds of a single sound instead. The engine moves on
+    to the next frame's features without resetting, so oscillator phases,
+    filters and the envelope run straight through frame boundaries (see
+    ImageSynthEngine::prepareSegment).
+
+    Frames are decoded one ahead on a second thread, and samples go to the
+    WAV writer block by block as they are rendered. Memory therefore holds
+    two frames and one block, whatever the length of the sequence.
+
+    In incremental mode the window grid is split into tiles of tileWindows x
+    tileWindows windows. A tile is only recomputed when a pixel under it
+    differs from the previous frame, so a mostly static animation costs a
+    compare per frame rather than a full extraction. Feature mappings need
+    the extended channels, which tiles don't track, so with one set every
+    frame is extracted in full.
+*/
+class SequenceRenderer
+{
+public:
+    struct Options
+    {
+        double framesPerSecond = 24.0;
+        bool incremental = true;
+        int tileWindows = 16;
+    };
+
+    struct Report
+    {
+        int framesRendered = 0;
+        int framesFailed = 0;           // unreadable; the previous frame's features were held instead
+        juce::int64 tilesRecomputed = 0, tilesTotal = 0;
+        double seconds = 0.0;
+    };
+
+    // Called after each frame, from the calling thread; return false to stop
+    using ProgressCallback = std::function<bool(int framesDone, int framesTotal)>;
+
+    // The folder's images in natural order, so frame_2 comes before frame_10
+    static juce::Array<juce::File> findFrames(const juce::File& folder);
+
+    // Renders frames in order into outputFile (16 bit mono, renamed into place when
+    // complete). params.soundDuration is ignored: the length is frames / framesPerSecond.
+    // Returns false if nothing could be written or onProgress stopped it.
+    static bool render(const juce::Array<juce::File>& frames, const juce::File& outputFile,
+                       const GenerationParameters& params, const Options& options,
+                       Report* report = nullptr, const ProgressCallback& onProgress = nullptr);
+};
@@ -8,7 +8,7 @@ SliderWindow::SliderWindow(ImagineAudioProcessorEditor* editor) : editor(editor)
     addSlider(kernel, kernel_label, "Kernel Size", 0, 50, 25,1, "Controls range of the sound generation algorithm. Warning CPU intensive at high values");
     addSlider(step, step_label, "Step Size", 0, 50, 10,1, "Controls steps of the sound generation algorithm. Changes which parts of the image are processed");
     addSlider(sound_level, sound_label, "Level", 0, 10, 1,.1, "Controls sound level, can also add distortion.");
-    addSlider(sound_duration, duration_label, "Time", 0, 30, 10,1, "Controls how long the sound lasts, can smoothen out the resultant sound.");
+    addSlider(sound_duration, duration_label, "Time", 0, 300, 10,1, "Controls how long the sound lasts, can smoothen out the resultant sound.");
     addSlider(modulation_intensity, modulation_intensity_label, "Modulation Intensity", 0, 1, .8,.1, "Controls the intensity of modulation filter");
     addSlider(modulation_envelope_intensity, envelope_intensity_label, "Envelope Intensity (Falloff)", .1, 1, .2,.1, "Controls the intensity of falloff of the modulation filter");
     addSlider(modulation_duration, modulation_duration_label, "Modulation Duration (Stretch)", -20, 20, 6,.1, "Controls how long the modulation filter lasts");
@@ -26,6 +26,18 @@ SliderWindow::SliderWindow(ImagineAudioProcessorEditor* editor) : editor(editor)
     baseToneGroup.setText("Base Tone");
     addAndMakeVisible(baseToneGroup);
 
+    autoResolution.setTooltip("Pick kernel and step size from the image size and duration, so large images take no longer than small ones");
+    soundGenerationGroup.addAndMakeVisible(autoResolution);
+
+    traversal.addItemList({ "Raster", "Column-major", "Serpentine", "Spiral", "Hilbert" }, 1);
+    traversal.setSelectedId(1, juce::dontSendNotification);
+    traversal.setTooltip("The order the image is read in, which becomes the order you hear it in");
+    soundGenerationGroup.addAndMakeVisible(traversal);
+
+    addFeatureSourceBox(fmDepthSource, modulationGroup, "FM depth", "Lets an image feature set the modulation depth as the sound plays");
+    addFeatureSourceBox(overtoneSource, baseToneGroup, "Overtones", "Lets an image feature set the number of overtones instead of brightness");
+    addFeatureSourceBox(lfoRateSource, baseToneGroup, "Lfo rate", "Lets an image feature speed up and slow down the LFO's as the sound plays");
+
     addAndMakeVisible(generateButton);
     generateButton.onClick = [editor] { editor->generateSound(); };
 
@@ -110,6 +122,10 @@ void SliderWindow::saveParameters(const juce::File& file)
     parameters->setAttribute("LfoIntensity", lfo_intensity.getValue());
     parameters->setAttribute("OvertoneNumScalar", overtone_num_scalar.getValue());
     parameters->setAttribute("LfoAmountScalar", lfo_amount_scalar.getValue());
+    parameters->setAttribute("Traversal", traversal.getSelectedId());
+    parameters->setAttribute("FmDepthSource", fmDepthSource.getSelectedId());
+    parameters->setAttribute("OvertoneSource", overtoneSource.getSelectedId());
+    parameters->setAttribute("LfoRateSource", lfoRateSource.getSelectedId());
 
     rootElement->addChildElement(parameters);
 
@@ -147,6 +163,10 @@ void SliderWindow::loadParameters(const juce::File& file)
     lfo_intensity.setValue(parameters->getDoubleAttribute("LfoIntensity", lfo_intensity.getValue()));
     overtone_num_scalar.setValue(parameters->getDoubleAttribute("OvertoneNumScalar", overtone_num_scalar.getValue()));
     lfo_amount_scalar.setValue(parameters->getDoubleAttribute("LfoAmountScalar", lfo_amount_scalar.getValue()));
+    traversal.setSelectedId(parameters->getIntAttribute("Traversal", traversal.getSelectedId()));
+    fmDepthSource.setSelectedId(parameters->getIntAttribute("FmDepthSource", fmDepthSource.getSelectedId()));
+    overtoneSource.setSelectedId(parameters->getIntAttribute("OvertoneSource", overtoneSource.getSelectedId()));
+    lfoRateSource.setSelectedId(parameters->getIntAttribute("LfoRateSource", lfoRateSource.getSelectedId()));
 }
 
 
@@ -157,6 +177,26 @@ void SliderWindow::paint(juce::Graphics& g)
     g.setFont(15.0f);
 }
 
+void SliderWindow::setGenerationProgress(GenerationStage stage, float progress)
+{
+    if (progress < 0.0f)
+    {
+        generateButton.setButtonText("Generate Sound");
+        return;
+    }
+
+    juce::String stageName;
+    switch (stage)
+    {
+    case GenerationStage::loadingImage:       stageName = "Loading image"; break;
+    case GenerationStage::extractingFeatures: stageName = "Analysing"; break;
+    case GenerationStage::synthesising:       stageName = "Generating"; break;
+    case GenerationStage::writing:            stageName = "Saving"; break;
+    }
+
+    generateButton.setButtonText(stageName + "... " + juce::String(juce::roundToInt(progress * 100.0f)) + "%");
+}
+
 void SliderWindow::resized()
 {
 
@@ -169,11 +209,14 @@ void SliderWindow::resized()
     setPositionWithinGroup(soundGenerationGroup, step, step_label, 0.3f, 0.02f, 0.25f, 0.30f);
     setPositionWithinGroup(soundGenerationGroup, sound_level, sound_label, 0.6f, 0.02f, 0.25f, 0.30f);
     setPositionWithinGroup(soundGenerationGroup, sound_duration, duration_label, 0.0f, 0.52f, 0.25f, 0.30f);
+    autoResolution.setBoundsRelative(0.3f, 0.66f, 0.6f, 0.12f);
+    traversal.setBoundsRelative(0.3f, 0.80f, 0.4f, 0.12f);
 
 
     setPositionWithinGroup(modulationGroup, modulation_intensity, modulation_intensity_label, 0.0f, 0.03f, 0.25f, 0.30f);
     setPositionWithinGroup(modulationGroup, modulation_envelope_intensity, envelope_intensity_label, 0.3f, 0.03f, 0.25f, 0.30f);
     setPositionWithinGroup(modulationGroup, modulation_duration, modulation_duration_label, 0.6f, 0.03f, 0.25f, 0.30f);
+    fmDepthSource.setBoundsRelative(0.0f, 0.62f, 0.55f, 0.12f);
 
 
     setPositionWithinGroup(baseToneGroup, overtone_num_scalar, overtone_num_label, 0.0f, 0.02f, 0.25f, 0.30f);
@@ -181,6 +224,8 @@ void SliderWindow::resized()
     setPositionWithinGroup(baseToneGroup, lfo_scalar_amplitude, lfo_amplitude_label, 0.6f, 0.02f, 0.25f, 0.30f);
     setPositionWithinGroup(baseToneGroup, lfo_intensity, lfo_intensity_label, 0.0f, 0.52f, 0.25f, 0.30f);
     setPositionWithinGroup(baseToneGroup, lfo_amount_scalar, lfo_amount_label, 0.3f, 0.52f, 0.25f, 0.30f);
+    overtoneSource.setBoundsRelative(0.6f, 0.56f, 0.35f, 0.12f);
+    lfoRateSource.setBoundsRelative(0.6f, 0.72f, 0.35f, 0.12f);
 
 
     generateButton.setBoundsRelative(0.1f, 0.87f, 0.8f, 0.04f);
@@ -190,6 +235,24 @@ void SliderWindow::resized()
 
 }
 
+void SliderWindow::addFeatureSourceBox(juce::ComboBox& box, juce::GroupComponent& group, const juce::String& control, const juce::String& tooltip)
+{
+    // The item names carry the control, since the boxes have no labels of their own
+    for (auto feature : { "Fixed", "Saturation", "Brightness", "Luminance variance", "Edge density" })
+        box.addItem(control + ": " + feature, box.getNumItems() + 1);
+
+    box.setSelectedId(1, juce::dontSendNotification);
+    box.setTooltip(tooltip);
+    group.addAndMakeVisible(box);
+}
+
+void SliderWindow::setAutoResolution(bool isAuto)
+{
+    autoResolution.setToggleState(isAuto, juce::dontSendNotification);
+    kernel.setEnabled(!isAuto);
+    step.setEnabled(!isAuto);
+}
+
 void SliderWindow::sliderValueChanged(juce::Slider* slider)
 {
 
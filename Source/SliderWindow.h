@@ -2,6 +2,7 @@
 #pragma once
 #include <JuceHeader.h>
 #include "PluginEditor.h"
+#include "GenerationQueue.h"
 #include <array>
 
 class ImagineAudioProcessorEditor;
@@ -29,8 +30,20 @@ public:
 	juce::Slider& getLfoScalarAmplitudeSlider() { return lfo_scalar_amplitude; }
 	juce::Slider& getLfoIntensitySlider() { return lfo_intensity; }
 	juce::Slider& getLfoAmountScalarSlider() { return lfo_amount_scalar; }
+	juce::ToggleButton& getAutoResolutionButton() { return autoResolution; }
+	juce::ComboBox& getTraversalBox() { return traversal; }     // item id is TraversalOrder + 1
+	juce::ComboBox& getFmDepthSourceBox() { return fmDepthSource; }     // item id is FeatureSource + 1
+	juce::ComboBox& getOvertoneSourceBox() { return overtoneSource; }
+	juce::ComboBox& getLfoRateSourceBox() { return lfoRateSource; }
+
+	// Auto resolution sets kernel and step itself, so the sliders only show what it chose
+	void setAutoResolution(bool isAuto);
 	void setPositionWithinGroup(juce::Component& group, juce::Slider& slider, juce::Label& label, float relX, float relY, float relWidth, float relHeight);
+	void addFeatureSourceBox(juce::ComboBox& box, juce::GroupComponent& group, const juce::String& control, const juce::String& tooltip);
+
 
+	// Shows generation progress on the Generate button; a negative progress resets it
+	void setGenerationProgress(GenerationStage stage, float progress);
 
 	void saveParameters(const juce::File& file);
 	void loadParameters(const juce::File& file);
@@ -48,6 +61,9 @@ private:
 
 	ImagineAudioProcessorEditor* editor;
 	juce::TextButton generateButton{ "Generate Sound" };
+	juce::ToggleButton autoResolution{ "Auto kernel/step" };
+	juce::ComboBox traversal;
+	juce::ComboBox fmDepthSource, overtoneSource, lfoRateSource;
 	juce::TooltipWindow tooltipWindow{ this, 500 };
 
 	juce::GroupComponent soundGenerationGroup;
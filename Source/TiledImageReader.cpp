@@ -0,0 +1,505 @@
+/*
+  ==============================================================================
+
+    TiledImageReader.cpp
+    Created: 18 Oct 2026 7:26:58am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#include "TiledImageReader.h"
+#include "ImageLoader.h"
+#include "ParallelFor.h"
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    // Packed 8 bit RGB scanlines, read top to bottom
+    class ScanlineSource
+    {
+    public:
+        virtual ~ScanlineSource() = default;
+        virtual bool readRows(uint8_t* rgb, int numRows) = 0;
+
+        int width = 0, height = 0;
+    };
+
+    //==============================================================================
+    // A PNG's IDAT chunks as one continuous zlib stream
+    class IdatStream : public juce::InputStream
+    {
+    public:
+        IdatStream(juce::InputStream& pngStream, int firstChunkLength)
+            : source(pngStream), remaining(firstChunkLength)
+        {
+        }
+
+        juce::int64 getTotalLength() override { return -1; }
+        juce::int64 getPosition() override { return position; }
+        bool setPosition(juce::int64) override { return false; }
+        bool isExhausted() override { return finished; }
+
+        int read(void* destBuffer, int maxBytesToRead) override
+        {
+            auto* dest = static_cast<char*>(destBuffer);
+            int done = 0;
+
+            while (done < maxBytesToRead && !finished)
+            {
+                if (remaining == 0)
+                {
+                    nextChunk();
+                    continue;
+                }
+
+                const int n = source.read(dest + done, juce::jmin(maxBytesToRead - done, remaining));
+                if (n <= 0)
+                {
+                    finished = true;
+                    break;
+                }
+
+                done += n;
+                remaining -= n;
+            }
+
+            position += done;
+            return done;
+        }
+
+    private:
+        // Steps over the finished chunk's CRC into the next IDAT, if there is one
+        void nextChunk()
+        {
+            source.skipNextBytes(4);
+
+            const int length = source.readIntBigEndian();
+            char type[4] = {};
+
+            if (source.read(type, 4) != 4 || std::memcmp(type, "IDAT", 4) != 0 || length < 0)
+                finished = true;
+            else
+                remaining = length;
+        }
+
+        juce::InputStream& source;
+        int remaining;
+        juce::int64 position = 0;
+        bool finished = false;
+    };
+
+    //==============================================================================
+    // Inflates and unfilters one scanline at a time, holding two rows of the file
+    class PngScanlines : public ScanlineSource
+    {
+    public:
+        // Null unless the file is a PNG this reader can stream
+        static std::unique_ptr<ScanlineSource> open(const juce::File& file)
+        {
+            std::unique_ptr<PngScanlines> png(new PngScanlines(file));
+            if (!png->readHeader())
+                return {};
+
+            return png;
+        }
+
+        bool readRows(uint8_t* rgb, int numRows) override
+        {
+            for (int r = 0; r < numRows; ++r)
+            {
+                const int rowSize = (int)current.size();
+
+                for (int done = 0; done < rowSize;)
+                {
+                    const int n = inflater->read(current.data() + done, rowSize - done);
+                    if (n <= 0)
+                        return false;
+
+                    done += n;
+                }
+
+                unfilter();
+                toRgb(rgb + (size_t)r * (size_t)width * 3);
+                std::swap(current, previous);
+            }
+
+            return true;
+        }
+
+    private:
+        explicit PngScanlines(const juce::File& file) : in(file) {}
+
+        bool readHeader()
+        {
+            uint8_t signature[8] = {};
+            if (!in.openedOk() || in.read(signature, 8) != 8 || std::memcmp(signature, "\x89PNG\r\n\x1a\n", 8) != 0)
+                return false;
+
+            while (!in.isExhausted())
+            {
+                const int length = in.readIntBigEndian();
+                char type[4] = {};
+
+                if (length < 0 || in.read(type, 4) != 4)
+                    return false;
+
+                if (std::memcmp(type, "IHDR", 4) == 0 && length >= 13)
+                {
+                    width = in.readIntBigEndian();
+                    height = in.readIntBigEndian();
+                    bitDepth = (uint8_t)in.readByte();
+                    colourType = (uint8_t)in.readByte();
+                    in.skipNextBytes(2);    // compression and filter method, both always 0
+                    const int interlace = in.readByte();
+                    in.skipNextBytes(length - 13 + 4);
+
+                    // Interlaced, palette below 8 bit and grey below 8 bit go to JUCE instead
+                    if (interlace != 0 || (bitDepth != 8 && (bitDepth != 16 || colourType == 3)))
+                        return false;
+                }
+                else if (std::memcmp(type, "PLTE", 4) == 0)
+                {
+                    palette.assign(256 * 3, 0);
+                    in.read(palette.data(), juce::jmin(length, (int)palette.size()));
+                    in.skipNextBytes(juce::jmax(0, length - (int)palette.size()) + 4);
+                }
+                else if (std::memcmp(type, "IDAT", 4) == 0)
+                {
+                    return startImageData(length);
+                }
+                else if (std::memcmp(type, "IEND", 4) == 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    in.skipNextBytes(length + 4);
+                }
+            }
+
+            return false;
+        }
+
+        bool startImageData(int firstChunkLength)
+        {
+            int channels = 0;
+            switch (colourType)
+            {
+                case 0: channels = 1; break;    // grey
+                case 2: channels = 3; break;    // RGB
+                case 3: channels = 1; break;    // palette
+                case 4: channels = 2; break;    // grey and alpha
+                case 6: channels = 4; break;    // RGBA
+                default: return false;
+            }
+
+            if (width <= 0 || height <= 0 || (colourType == 3 && palette.empty()))
+                return false;
+
+            bytesPerPixel = channels * bitDepth / 8;
+
+            // Each row starts with its filter type
+            current.assign((size_t)width * (size_t)bytesPerPixel + 1, 0);
+            previous.assign(current.size(), 0);
+
+            idat = std::make_unique<IdatStream>(in, firstChunkLength);
+            inflater = std::make_unique<juce::GZIPDecompressorInputStream>(idat.get(), false,
+                                                                           juce::GZIPDecompressorInputStream::zlibFormat);
+            return true;
+        }
+
+        // Undoes the row's PNG filter, in place, against the row above
+        void unfilter()
+        {
+            uint8_t* row = current.data() + 1;
+            const uint8_t* above = previous.data() + 1;
+            const size_t n = current.size() - 1;
+            const size_t bpp = (size_t)bytesPerPixel;
+
+            switch (current[0])
+            {
+                case 1:     // sub
+                    for (size_t i = bpp; i < n; ++i)
+                        row[i] = (uint8_t)(row[i] + row[i - bpp]);
+                    break;
+
+                case 2:     // up
+                    for (size_t i = 0; i < n; ++i)
+                        row[i] = (uint8_t)(row[i] + above[i]);
+                    break;
+
+                case 3:     // average
+                    for (size_t i = 0; i < n; ++i)
+                        row[i] = (uint8_t)(row[i] + (((i >= bpp ? row[i - bpp] : 0) + above[i]) >> 1));
+                    break;
+
+                case 4:     // paeth
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        const int a = i >= bpp ? row[i - bpp] : 0;
+                        const int b = above[i];
+                        const int c = i >= bpp ? above[i - bpp] : 0;
+                        const int p = a + b - c;
+                        const int pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+
+                        row[i] = (uint8_t)(row[i] + (pa <= pb && pa <= pc ? a : pb <= pc ? b : c));
+                    }
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+        // Alpha is dropped as PIL's convert('RGB') does; 16 bit samples keep their high byte
+        void toRgb(uint8_t* out) const
+        {
+            const uint8_t* row = current.data() + 1;
+            const int sampleBytes = bitDepth / 8;
+
+            for (int x = 0; x < width; ++x, out += 3)
+            {
+                const uint8_t* pixel = row + (size_t)x * (size_t)bytesPerPixel;
+
+                switch (colourType)
+                {
+                    case 0:
+                    case 4:
+                        out[0] = out[1] = out[2] = pixel[0];
+                        break;
+
+                    case 3:
+                        std::memcpy(out, palette.data() + (size_t)pixel[0] * 3, 3);
+                        break;
+
+                    default:
+                        out[0] = pixel[0];
+                        out[1] = pixel[sampleBytes];
+                        out[2] = pixel[2 * sampleBytes];
+                        break;
+                }
+            }
+        }
+
+        juce::FileInputStream in;
+        std::unique_ptr<IdatStream> idat;
+        std::unique_ptr<juce::GZIPDecompressorInputStream> inflater;
+
+        uint8_t bitDepth = 0, colourType = 0;
+        int bytesPerPixel = 0;
+        std::vector<uint8_t> palette;
+        std::vector<uint8_t> current, previous;
+    };
+
+    //==============================================================================
+    // Anything that can't be streamed is decoded whole by JUCE, at full size, and walked row by row
+    class DecodedScanlines : public ScanlineSource
+    {
+    public:
+        explicit DecodedScanlines(const juce::Image& decoded)
+            : image(decoded), bitmap(image, juce::Image::BitmapData::readOnly)
+        {
+            width = image.getWidth();
+            height = image.getHeight();
+        }
+
+        bool readRows(uint8_t* rgb, int numRows) override
+        {
+            const auto format = image.getFormat();
+
+            for (int r = 0; r < numRows && nextRow < height; ++r, ++nextRow)
+            {
+                uint8_t* out = rgb + (size_t)r * (size_t)width * 3;
+
+                for (int x = 0; x < width; ++x, out += 3)
+                {
+                    const uint8_t* p = bitmap.getPixelPointer(x, nextRow);
+
+                    switch (format)
+                    {
+                        case juce::Image::RGB:
+                        {
+                            const auto* pixel = reinterpret_cast<const juce::PixelRGB*>(p);
+                            out[0] = pixel->getRed(); out[1] = pixel->getGreen(); out[2] = pixel->getBlue();
+                            break;
+                        }
+                        case juce::Image::ARGB:
+                        {
+                            auto pixel = *reinterpret_cast<const juce::PixelARGB*>(p);
+                            pixel.unpremultiply();
+                            out[0] = pixel.getRed(); out[1] = pixel.getGreen(); out[2] = pixel.getBlue();
+                            break;
+                        }
+                        default:
+                            out[0] = out[1] = out[2] = *p;
+                            break;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+    private:
+        juce::Image image;
+        juce::Image::BitmapData bitmap;
+        int nextRow = 0;
+    };
+
+    std::unique_ptr<ScanlineSource> openScanlines(const juce::File& file)
+    {
+        if (auto png = PngScanlines::open(file))
+            return png;
+
+        // Costs the whole decoded image, but still no summed-area tables
+        const juce::Image image = juce::ImageFileFormat::loadFrom(file);
+        if (!image.isValid())
+            return {};
+
+        return std::make_unique<DecodedScanlines>(image);
+    }
+}
+
+bool TiledImageReader::shouldUse(const juce::File& file)
+{
+    int width = 0, height = 0;
+
+    return ImageLoader::isSupportedImage(file)
+        && ImageLoader::readSize(file, width, height)
+        && (juce::int64)width * (juce::int64)height > maxDecodedPixels;
+}
+
+ImageFeatures TiledImageReader::computeBlockMeans(const juce::File& file, int kernelSize, int stepSize,
+                                                  TraversalOrder order, const ProgressCallback& onProgress)
+{
+    auto source = openScanlines(file);
+    if (source == nullptr)
+    {
+        DBG("Error: could not decode image " << file.getFullPathName());
+        return {};
+    }
+
+    const int width = source->width;
+    const int height = source->height;
+
+    if (kernelSize <= 0 || stepSize <= 0)
+        throw std::invalid_argument("Kernel size and step size must be positive");
+
+    if (kernelSize > height || kernelSize > width)
+        throw std::invalid_argument("Kernel size cannot be larger than the image");
+
+    const int numRows = (height - kernelSize) / stepSize + 1;
+    const int numCols = (width - kernelSize) / stepSize + 1;
+    const size_t numWindows = (size_t)numRows * (size_t)numCols;
+
+    ImageFeatures features;
+    features.red.resize(numWindows);
+    features.green.resize(numWindows);
+    features.blue.resize(numWindows);
+
+    std::array<float*, 3> outputs{ features.red.data(), features.green.data(), features.blue.data() };
+    const double windowArea = (double)kernelSize * (double)kernelSize;
+    const auto ranks = WindowTraversal::computeRanks(order, numRows, numCols);
+
+    // Scanlines below the last window row are never read
+    const int usedRows = (numRows - 1) * stepSize + kernelSize;
+
+    const size_t rowBytes = (size_t)width * 3;
+    const size_t sumsPerRow = (size_t)numCols * 3;          // [channel][column]
+    const size_t bytesPerRow = rowBytes + sumsPerRow * sizeof(uint32_t);
+    const int rowsPerStrip = (int)juce::jlimit((size_t)1, (size_t)usedRows, tileBudgetBytes / bytesPerRow);
+
+    std::vector<uint8_t> strip((size_t)rowsPerStrip * rowBytes);
+    std::vector<uint32_t> rowSums((size_t)rowsPerStrip * sumsPerRow);
+
+    // Window rows still collecting scanlines; at most ceil(kernel / step) are open at once
+    const int ringSize = (kernelSize + stepSize - 1) / stepSize + 1;
+    std::vector<uint64_t> openRows((size_t)ringSize * sumsPerRow, 0);
+
+    for (int stripStart = 0; stripStart < usedRows; stripStart += rowsPerStrip)
+    {
+        const int stripRows = juce::jmin(rowsPerStrip, usedRows - stripStart);
+
+        if (!source->readRows(strip.data(), stripRows))
+        {
+            DBG("Error: image data ends early in " << file.getFullPathName());
+            return {};
+        }
+
+        // Each scanline's sums over every window's columns
+        parallelFor(0, stripRows, 16, [&](int rowBegin, int rowEnd)
+            {
+                std::vector<uint32_t> prefix((size_t)width + 1, 0);
+
+                for (int r = rowBegin; r < rowEnd; ++r)
+                {
+                    const uint8_t* pixels = strip.data() + (size_t)r * rowBytes;
+                    uint32_t* sums = rowSums.data() + (size_t)r * sumsPerRow;
+
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        for (int x = 0; x < width; ++x)
+                            prefix[(size_t)x + 1] = prefix[(size_t)x] + pixels[(size_t)x * 3 + (size_t)c];
+
+                        for (int col = 0; col < numCols; ++col)
+                        {
+                            const size_t left = (size_t)col * (size_t)stepSize;
+                            sums[(size_t)c * (size_t)numCols + (size_t)col] = prefix[left + (size_t)kernelSize] - prefix[left];
+                        }
+                    }
+                }
+            });
+
+        // Added into the window rows they belong to. Columns are split across
+        // cores, so each one owns its slice of every open row.
+        parallelFor(0, numCols, 256, [&](int colBegin, int colEnd)
+            {
+                for (int r = 0; r < stripRows; ++r)
+                {
+                    const int y = stripStart + r;
+                    const int firstWindowRow = y < kernelSize ? 0 : (y - kernelSize) / stepSize + 1;
+                    const int lastWindowRow = juce::jmin(y / stepSize, numRows - 1);
+                    const uint32_t* sums = rowSums.data() + (size_t)r * sumsPerRow;
+
+                    for (int w = firstWindowRow; w <= lastWindowRow; ++w)
+                    {
+                        uint64_t* open = openRows.data() + (size_t)(w % ringSize) * sumsPerRow;
+                        const bool complete = y == w * stepSize + kernelSize - 1;
+
+                        for (int c = 0; c < 3; ++c)
+                        {
+                            const size_t offset = (size_t)c * (size_t)numCols;
+
+                            for (int col = colBegin; col < colEnd; ++col)
+                                open[offset + (size_t)col] += sums[offset + (size_t)col];
+
+                            if (!complete)
+                                continue;
+
+                            float* out = outputs[c];
+
+                            for (int col = colBegin; col < colEnd; ++col)
+                            {
+                                const double mean = (double)open[offset + (size_t)col] / windowArea;
+
+                                // Matches (np.mean(window) + 1e-12) / 256 in image_convolution
+                                out[WindowTraversal::getRank(ranks, w, col, numCols)] = (float)((mean + 0.000000000001) / 256.0);
+                                open[offset + (size_t)col] = 0;
+                            }
+                        }
+                    }
+                }
+            });
+
+        if (onProgress != nullptr && !onProgress((float)(stripStart + stripRows) / (float)usedRows))
+            return {};
+    }
+
+    return features;
+}
@@ -0,0 +1,58 @@
+/*
+  ==============================================================================
+
+    TiledImageReader.h
+    Created: 18 Oct 2026 7:26:58am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "ImageFeatures.h"
+#include <functional>
+
+//==============================================================================
+/**
+    Block means for images too large to decode whole, at full resolution.
+
+    Nothing is squashed to 3840x2160 any more. Anything that fits in
+    maxDecodedPixels is decoded whole by ImageLoader at its native size and
+    gets a pyramid. Beyond that the image is read as strips of scanlines. Each strip becomes
+    one row of window sums per scanline, is added to the rows of windows
+    still open, and is then discarded. A window row is written out as soon as
+    its last scanline has been added. Working memory is one strip
+    (tileBudgetBytes) plus ceil(kernel / step) rows of window sums, however
+    large the image.
+
+    Window rows complete top to bottom whatever the TraversalOrder, so each
+    finished row is written straight to its windows' ranks.
+
+    Only PNGs (8 or 16 bit, not interlaced) can be streamed; they are
+    inflated as they are read. JUCE has no incremental JPEG decoder, so an
+    oversized JPEG (or interlaced PNG) is decoded whole and then walked the
+    same way. That costs the decoded image but still saves the summed-area
+    tables.
+*/
+class TiledImageReader
+{
+public:
+    // Called after each strip; return false to stop
+    using ProgressCallback = std::function<bool(float progress)>;
+
+    static constexpr size_t tileBudgetBytes = 64 * 1024 * 1024;
+
+    // About 256 MB as a decoded juce::Image, before the summed-area tables
+    static constexpr juce::int64 maxDecodedPixels = 64 * 1024 * 1024;
+
+    // True for images over maxDecodedPixels
+    static bool shouldUse(const juce::File& file);
+
+    // Same windows, values and order as IntegralImage::computeBlockMeans on the full-size
+    // image, and it throws the same std::invalid_argument messages. Empty if the file
+    // can't be read or onProgress stopped it.
+    static ImageFeatures computeBlockMeans(const juce::File& file, int kernelSize, int stepSize,
+                                           TraversalOrder order = TraversalOrder::raster,
+                                           const ProgressCallback& onProgress = nullptr);
+};
@@ -0,0 +1,258 @@
+/*
+  ==============================================================================
+
+    WatchFolder.cpp
+    Created: 18 Oct 2026 7:10:39am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#include "WatchFolder.h"
+#include "BatchConverter.h"
+#include "ImageLoader.h"
+
+#if JUCE_LINUX
+ #include <poll.h>
+ #include <sys/inotify.h>
+ #include <unistd.h>
+#elif JUCE_WINDOWS
+ #include <windows.h>
+#endif
+
+//==============================================================================
+// Waits for changes in one directory and reports the files that may have
+// changed. inotify names them; the other backends rescan and compare.
+class WatchFolder::Notifier
+{
+public:
+    explicit Notifier(const juce::File& dir)
+        : directory(dir)
+    {
+       #if JUCE_LINUX
+        fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (fd >= 0)
+            inotify_add_watch(fd, directory.getFullPathName().toRawUTF8(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_MODIFY);
+       #else
+        rescan();
+
+        #if JUCE_WINDOWS
+        handle = FindFirstChangeNotificationW(directory.getFullPathName().toWideCharPointer(), FALSE,
+                                              FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE);
+        #endif
+       #endif
+    }
+
+    ~Notifier()
+    {
+       #if JUCE_LINUX
+        if (fd >= 0)
+            close(fd);
+       #elif JUCE_WINDOWS
+        if (handle != INVALID_HANDLE_VALUE)
+            FindCloseChangeNotification(handle);
+       #endif
+    }
+
+    // Waits up to timeoutMs; returns the files that changed, often none
+    juce::Array<juce::File> wait(int timeoutMs)
+    {
+       #if JUCE_LINUX
+        if (fd < 0)
+            return poll(timeoutMs);
+
+        pollfd request{ fd, POLLIN, 0 };
+        if (::poll(&request, 1, timeoutMs) <= 0)
+            return {};
+
+        juce::Array<juce::File> changed;
+        bool overflowed = false;
+        alignas(inotify_event) char buffer[4096];
+
+        for (;;)
+        {
+            const ssize_t length = read(fd, buffer, sizeof(buffer));
+            if (length <= 0)
+                break;
+
+            for (ssize_t offset = 0; offset < length;)
+            {
+                const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                if ((event->mask & IN_Q_OVERFLOW) != 0)
+                    overflowed = true;
+                else if (event->len > 0)
+                    changed.addIfNotAlreadyThere(directory.getChildFile(event->name));
+
+                offset += (ssize_t)sizeof(inotify_event) + (ssize_t)event->len;
+            }
+        }
+
+        // Events were dropped, so any file may have changed
+        if (overflowed)
+            return directory.findChildFiles(juce::File::findFiles, false);
+
+        return changed;
+       #elif JUCE_WINDOWS
+        if (handle == INVALID_HANDLE_VALUE)
+            return poll(timeoutMs);
+
+        if (WaitForSingleObject(handle, (DWORD)timeoutMs) != WAIT_OBJECT_0)
+            return {};
+
+        FindNextChangeNotification(handle);
+        return rescan();
+       #else
+        return poll(timeoutMs);
+       #endif
+    }
+
+private:
+    // Fallback when there's no notification API: rescan about once a second
+    juce::Array<juce::File> poll(int timeoutMs)
+    {
+        juce::Thread::sleep(timeoutMs);
+
+        const juce::int64 now = juce::Time::currentTimeMillis();
+        if (now - lastScan < 1000)
+            return {};
+
+        return rescan();
+    }
+
+    juce::Array<juce::File> rescan()
+    {
+        lastScan = juce::Time::currentTimeMillis();
+
+        std::map<juce::String, std::pair<juce::int64, juce::int64>> current;
+        juce::Array<juce::File> changed;
+
+        for (const auto& file : directory.findChildFiles(juce::File::findFiles, false))
+        {
+            const std::pair<juce::int64, juce::int64> state{ file.getSize(), file.getLastModificationTime().toMilliseconds() };
+            const auto path = file.getFullPathName();
+
+            auto previous = snapshot.find(path);
+            if (previous == snapshot.end() || previous->second != state)
+                changed.add(file);
+
+            current[path] = state;
+        }
+
+        snapshot = std::move(current);
+        return changed;
+    }
+
+    juce::File directory;
+    std::map<juce::String, std::pair<juce::int64, juce::int64>> snapshot;     // path -> size, modified
+    juce::int64 lastScan = 0;
+
+   #if JUCE_LINUX
+    int fd = -1;
+   #elif JUCE_WINDOWS
+    HANDLE handle = INVALID_HANDLE_VALUE;
+   #endif
+};
+
+//==============================================================================
+WatchFolder::WatchFolder(ParametersProvider parameters, std::string output)
+    : juce::Thread("Watch folder"), getParameters(std::move(parameters)), outputPath(std::move(output))
+{
+}
+
+WatchFolder::~WatchFolder()
+{
+    stop();
+}
+
+bool WatchFolder::start(const juce::File& newFolder)
+{
+    stop();
+
+    if (!newFolder.isDirectory())
+        return false;
+
+    folder = newFolder;
+    startThread();
+    return true;
+}
+
+void WatchFolder::stop()
+{
+    // A conversion in progress stops at its next render block
+    stopThread(30000);
+}
+
+void WatchFolder::setOnConverted(ConvertedCallback callback)
+{
+    const juce::ScopedLock lock(callbackLock);
+    onConverted = std::move(callback);
+}
+
+void WatchFolder::run()
+{
+    Notifier notifier(folder);
+
+    // Path -> time of the last change seen. What's already there may still be
+    // being copied in, so it waits out the debounce like anything else.
+    std::map<juce::String, juce::int64> pending;
+    const juce::int64 started = juce::Time::currentTimeMillis();
+
+    for (const auto& file : folder.findChildFiles(juce::File::findFiles, false))
+        if (ImageLoader::isSupportedImage(file))
+            pending[file.getFullPathName()] = started;
+
+    while (!threadShouldExit())
+    {
+        const juce::int64 now = juce::Time::currentTimeMillis();
+
+        for (const auto& file : notifier.wait(200))
+            if (ImageLoader::isSupportedImage(file))
+                pending[file.getFullPathName()] = now;
+
+        // Anything quiet for debounceMs has finished being written
+        juce::Array<juce::File> ready;
+
+        for (auto it = pending.begin(); it != pending.end();)
+        {
+            if (juce::Time::currentTimeMillis() - it->second < debounceMs)
+            {
+                ++it;
+                continue;
+            }
+
+            const juce::File file(it->first);
+            if (file.existsAsFile())
+                ready.add(file);
+
+            it = pending.erase(it);
+        }
+
+        if (ready.isEmpty())
+            continue;
+
+        BatchConverter converter;
+        converter.shouldStop = [this] { return threadShouldExit(); };
+
+        const auto written = converter.run(ready, outputPath, getParameters());
+
+        ConvertedCallback callback;
+        {
+            const juce::ScopedLock lock(callbackLock);
+            callback = onConverted;
+        }
+
+        if (callback == nullptr)
+            continue;
+
+        for (size_t i = 0; i < written.size(); ++i)
+        {
+            if (written[i] == juce::File())
+                continue;
+
+            juce::MessageManager::callAsync([callback, image = ready[(int)i], output = written[i]]
+                {
+                    callback(image, output);
+                });
+        }
+    }
+}
@@ -0,0 +1,71 @@
+/*
+  ==============================================================================
+
+    WatchFolder.h
+    Created: 18 Oct 2026 7:10:39am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "ImageSynthEngine.h"
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+//==============================================================================
+/**
+    Converts images as they appear in a folder.
+
+    Changes come from the OS (inotify on Linux, change notifications on
+    Windows; other platforms rescan once a second). Each image waits until
+    it has been quiet for debounceMs, so a file that is still being written
+    is converted once, when it's complete. Ready images go through
+    BatchConverter with whatever parameters are current at that moment; its
+    manifest skips anything already up to date, and WAVs are published with
+    an atomic rename.
+
+    Images already in the folder when watching starts are converted too,
+    after the same quiet period, in case one was still being copied in. If
+    the OS drops events (an inotify queue overflow), the whole folder is
+    treated as changed and the manifest sorts out what's new.
+*/
+class WatchFolder : private juce::Thread
+{
+public:
+    // Called on the watch thread before each conversion
+    using ParametersProvider = std::function<GenerationParameters()>;
+
+    WatchFolder(ParametersProvider parameters, std::string outputPath);
+    ~WatchFolder() override;
+
+    bool start(const juce::File& folder);
+    void stop();
+
+    bool isWatching() const { return isThreadRunning(); }
+    juce::File getFolder() const { return folder; }
+
+    // Called on the message thread for each image converted or already up to date.
+    // Safe to set while watching.
+    using ConvertedCallback = std::function<void(const juce::File& image, const juce::File& output)>;
+    void setOnConverted(ConvertedCallback callback);
+
+    static constexpr int debounceMs = 750;
+
+private:
+    class Notifier;
+
+    void run() override;
+
+    ParametersProvider getParameters;
+    std::string outputPath;
+    juce::File folder;
+
+    juce::CriticalSection callbackLock;
+    ConvertedCallback onConverted;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WatchFolder)
+};
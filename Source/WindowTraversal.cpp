@@ -0,0 +1,196 @@
+/*
+  ==============================================================================
+
+    WindowTraversal.cpp
+    Created: 18 Oct 2026 7:34:41am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#include "WindowTraversal.h"
+
+namespace
+{
+    int sign(int value)
+    {
+        return (value > 0) - (value < 0);
+    }
+
+    // Division rounding towards minus infinity, as the curve's halving needs
+    int floorHalf(int value)
+    {
+        return value >= 0 ? value / 2 : -((1 - value) / 2);
+    }
+
+    //==============================================================================
+    // Generalised Hilbert curve (Červený's gilbert2d): fills the rectangle spanned
+    // by the major axis (ax, ay) and the minor axis (bx, by) from (x, y), splitting
+    // it in two or three sub-rectangles until one side is a single window.
+    struct HilbertWalk
+    {
+        std::vector<int>& ranks;
+        int numCols;
+        int next = 0;
+
+        void visit(int x, int y)
+        {
+            ranks[(size_t)(y * numCols + x)] = next++;
+        }
+
+        void fill(int x, int y, int ax, int ay, int bx, int by)
+        {
+            const int w = std::abs(ax + ay);
+            const int h = std::abs(bx + by);
+            const int dax = sign(ax), day = sign(ay);
+            const int dbx = sign(bx), dby = sign(by);
+
+            if (h == 1)
+            {
+                for (int i = 0; i < w; ++i, x += dax, y += day)
+                    visit(x, y);
+                return;
+            }
+
+            if (w == 1)
+            {
+                for (int i = 0; i < h; ++i, x += dbx, y += dby)
+                    visit(x, y);
+                return;
+            }
+
+            int ax2 = floorHalf(ax), ay2 = floorHalf(ay);
+            int bx2 = floorHalf(bx), by2 = floorHalf(by);
+            const int w2 = std::abs(ax2 + ay2);
+            const int h2 = std::abs(bx2 + by2);
+
+            if (2 * w > 3 * h)
+            {
+                // Long and thin: split along the major axis only
+                if ((w2 % 2) != 0 && w > 2)
+                {
+                    ax2 += dax;
+                    ay2 += day;
+                }
+
+                fill(x, y, ax2, ay2, bx, by);
+                fill(x + ax2, y + ay2, ax - ax2, ay - ay2, bx, by);
+            }
+            else
+            {
+                if ((h2 % 2) != 0 && h > 2)
+                {
+                    bx2 += dbx;
+                    by2 += dby;
+                }
+
+                fill(x, y, bx2, by2, ax2, ay2);
+                fill(x + bx2, y + by2, ax, ay, bx - bx2, by - by2);
+                fill(x + (ax - dax) + (bx2 - dbx), y + (ay - day) + (by2 - dby), -bx2, -by2, -(ax - ax2), -(ay - ay2));
+            }
+        }
+    };
+
+    // A clockwise spiral from the outside in, numbered backwards so it starts at the centre
+    void fillSpiral(std::vector<int>& ranks, int numRows, int numCols)
+    {
+        int top = 0, bottom = numRows - 1, left = 0, right = numCols - 1;
+        int next = numRows * numCols - 1;
+
+        auto visit = [&](int row, int col) { ranks[(size_t)(row * numCols + col)] = next--; };
+
+        while (top <= bottom && left <= right)
+        {
+            for (int col = left; col <= right; ++col)
+                visit(top, col);
+
+            for (int row = top + 1; row <= bottom; ++row)
+                visit(row, right);
+
+            if (top < bottom)
+                for (int col = right - 1; col >= left; --col)
+                    visit(bottom, col);
+
+            if (left < right)
+                for (int row = bottom - 1; row > top; --row)
+                    visit(row, left);
+
+            ++top;
+            --bottom;
+            ++left;
+            --right;
+        }
+    }
+}
+
+juce::String WindowTraversal::getName(TraversalOrder order)
+{
+    switch (order)
+    {
+        case TraversalOrder::raster:      return "raster";
+        case TraversalOrder::columnMajor: return "column";
+        case TraversalOrder::serpentine:  return "serpentine";
+        case TraversalOrder::spiral:      return "spiral";
+        case TraversalOrder::hilbert:     return "hilbert";
+    }
+
+    return "raster";
+}
+
+bool WindowTraversal::fromName(const juce::String& name, TraversalOrder& order)
+{
+    for (int i = 0; i < numOrders; ++i)
+    {
+        if (name.trim().equalsIgnoreCase(getName((TraversalOrder)i)))
+        {
+            order = (TraversalOrder)i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+std::vector<int> WindowTraversal::computeRanks(TraversalOrder order, int numRows, int numCols)
+{
+    if (order == TraversalOrder::raster || numRows <= 0 || numCols <= 0)
+        return {};
+
+    std::vector<int> ranks((size_t)numRows * (size_t)numCols);
+
+    switch (order)
+    {
+        case TraversalOrder::columnMajor:
+            for (int row = 0; row < numRows; ++row)
+                for (int col = 0; col < numCols; ++col)
+                    ranks[(size_t)(row * numCols + col)] = col * numRows + row;
+            break;
+
+        case TraversalOrder::serpentine:
+            for (int row = 0; row < numRows; ++row)
+                for (int col = 0; col < numCols; ++col)
+                    ranks[(size_t)(row * numCols + col)] = row * numCols + ((row % 2) == 0 ? col : numCols - 1 - col);
+            break;
+
+        case TraversalOrder::spiral:
+            fillSpiral(ranks, numRows, numCols);
+            break;
+
+        case TraversalOrder::hilbert:
+        {
+            // x runs along columns; the longer side is the major axis
+            HilbertWalk walk{ ranks, numCols };
+
+            if (numCols >= numRows)
+                walk.fill(0, 0, numCols, 0, 0, numRows);
+            else
+                walk.fill(0, 0, 0, numRows, numCols, 0);
+            break;
+        }
+
+        case TraversalOrder::raster:
+            break;
+    }
+
+    return ranks;
+}
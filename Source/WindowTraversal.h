@@ -0,0 +1,55 @@
+/*
+  ==============================================================================
+
+    WindowTraversal.h
+    Created: 18 Oct 2026 7:34:41am
+    Author:  Adison
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+
+// The order windows are laid out in the feature arrays, and so the order the
+// synthesis hears them in. raster is image_convolution's rows-then-columns.
+enum class TraversalOrder
+{
+    raster,
+    columnMajor,        // top to bottom, then left to right
+    serpentine,         // raster with every other row reversed, so neighbours stay adjacent
+    spiral,             // outwards from the centre of the grid
+    hilbert             // space-filling curve; generalised to any grid size
+};
+
+//==============================================================================
+/**
+    Maps window positions to their place in a TraversalOrder.
+
+    Block means are never gathered from raster order. Extraction walks the
+    window grid in square tiles of tileWindows x tileWindows, which keeps the
+    summed-area table reads as local as a raster walk, and writes each mean
+    straight to its rank. Column-major and Hilbert orders on a large image
+    therefore cost one rank lookup per window over raster.
+*/
+class WindowTraversal
+{
+public:
+    static constexpr int numOrders = 5;
+    static constexpr int tileWindows = 32;
+
+    // "raster", "column", "serpentine", "spiral" or "hilbert"
+    static juce::String getName(TraversalOrder order);
+    static bool fromName(const juce::String& name, TraversalOrder& order);
+
+    // ranks[row * numCols + col] is that window's index in the order. Empty for
+    // raster, where the rank is the raster index itself.
+    static std::vector<int> computeRanks(TraversalOrder order, int numRows, int numCols);
+
+    static int getRank(const std::vector<int>& ranks, int row, int col, int numCols)
+    {
+        const int index = row * numCols + col;
+        return ranks.empty() ? index : ranks[(size_t)index];
+    }
+};